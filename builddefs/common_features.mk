@@ -268,6 +268,11 @@ else
   endif
 endif
 
+ifeq ($(strip $(EECONFIG_CACHE_ENABLE)), yes)
+    OPT_DEFS += -DEECONFIG_CACHE_ENABLE
+    FNV_ENABLE := yes
+endif
+
 VALID_WEAR_LEVELING_DRIVER_TYPES := custom embedded_flash spi_flash rp2040_flash legacy
 WEAR_LEVELING_DRIVER ?= none
 ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
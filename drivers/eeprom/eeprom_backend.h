@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Included by EEPROM driver implementations in place of eeprom_driver.h. When the write cache is enabled, the
+// implementation's block accessors and erase are renamed so that eeprom_driver.c can provide the public versions in
+// front of them.
+
+#include "eeprom_driver.h"
+
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+#    define eeprom_read_block eeprom_backend_read_block
+#    define eeprom_write_block eeprom_backend_write_block
+#    define eeprom_driver_erase eeprom_backend_erase
+#endif // EEPROM_WRITE_CACHE_ENABLE
@@ -19,6 +19,143 @@
 
 #include "eeprom_driver.h"
 
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+#    include "timer.h"
+#    include "util.h"
+
+#    ifndef EEPROM_WRITE_CACHE_LINES
+#        define EEPROM_WRITE_CACHE_LINES 8
+#    endif
+
+#    ifndef EEPROM_WRITE_CACHE_LINE_SIZE
+#        define EEPROM_WRITE_CACHE_LINE_SIZE 16
+#    endif
+
+#    ifndef EEPROM_WRITE_CACHE_IDLE_MS
+#        define EEPROM_WRITE_CACHE_IDLE_MS 3000
+#    endif
+
+_Static_assert(EEPROM_WRITE_CACHE_LINE_SIZE <= 32 && (EEPROM_WRITE_CACHE_LINE_SIZE & (EEPROM_WRITE_CACHE_LINE_SIZE - 1)) == 0, "EEPROM_WRITE_CACHE_LINE_SIZE must be a power of two, no larger than 32");
+
+// Each line holds the pending writes for one aligned span of EEPROM, with a bit per byte noting which bytes are held.
+// A line with no dirty bytes is free.
+typedef struct {
+    uintptr_t base;
+    uint32_t  dirty;
+    uint8_t   data[EEPROM_WRITE_CACHE_LINE_SIZE];
+} eeprom_cache_line_t;
+
+static eeprom_cache_line_t cache_lines[EEPROM_WRITE_CACHE_LINES];
+static uint8_t             cache_victim     = 0;
+static uint32_t            cache_last_write = 0;
+
+// Commits each run of dirty bytes in the line, skipping runs whose contents already match the backend -- such as a
+// setting that was changed and then changed back before the commit.
+static void eeprom_cache_flush_line(eeprom_cache_line_t *line) {
+    uint8_t offset = 0;
+    while (offset < EEPROM_WRITE_CACHE_LINE_SIZE) {
+        if (!(line->dirty & (1UL << offset))) {
+            ++offset;
+            continue;
+        }
+
+        uint8_t end = offset;
+        while (end < EEPROM_WRITE_CACHE_LINE_SIZE && (line->dirty & (1UL << end))) {
+            ++end;
+        }
+
+        uint8_t current[EEPROM_WRITE_CACHE_LINE_SIZE];
+        eeprom_backend_read_block(current, (const void *)(line->base + offset), end - offset);
+        if (memcmp(current, &line->data[offset], end - offset) != 0) {
+            eeprom_backend_write_block(&line->data[offset], (void *)(line->base + offset), end - offset);
+        }
+        offset = end;
+    }
+    line->dirty = 0;
+}
+
+static eeprom_cache_line_t *eeprom_cache_get_line(uintptr_t base) {
+    eeprom_cache_line_t *free_line = NULL;
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; ++i) {
+        if (cache_lines[i].dirty == 0) {
+            if (!free_line) {
+                free_line = &cache_lines[i];
+            }
+        } else if (cache_lines[i].base == base) {
+            return &cache_lines[i];
+        }
+    }
+
+    // No free lines left, so commit one to make room
+    if (!free_line) {
+        free_line    = &cache_lines[cache_victim];
+        cache_victim = (cache_victim + 1) % EEPROM_WRITE_CACHE_LINES;
+        eeprom_cache_flush_line(free_line);
+    }
+
+    free_line->base = base;
+    return free_line;
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_backend_read_block(buf, addr, len);
+
+    // Overlay any writes that have yet to be committed
+    uintptr_t start = (uintptr_t)addr;
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; ++i) {
+        eeprom_cache_line_t *line = &cache_lines[i];
+        if (line->dirty == 0 || line->base + EEPROM_WRITE_CACHE_LINE_SIZE <= start || line->base >= start + len) {
+            continue;
+        }
+        for (uint8_t offset = 0; offset < EEPROM_WRITE_CACHE_LINE_SIZE; ++offset) {
+            uintptr_t pos = line->base + offset;
+            if ((line->dirty & (1UL << offset)) && pos >= start && pos < start + len) {
+                ((uint8_t *)buf)[pos - start] = line->data[offset];
+            }
+        }
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *src = (const uint8_t *)buf;
+    uintptr_t      pos = (uintptr_t)addr;
+    while (len > 0) {
+        uintptr_t            base   = pos & ~(uintptr_t)(EEPROM_WRITE_CACHE_LINE_SIZE - 1);
+        uint8_t              offset = pos - base;
+        uint8_t              count  = MIN(len, (size_t)(EEPROM_WRITE_CACHE_LINE_SIZE - offset));
+        eeprom_cache_line_t *line   = eeprom_cache_get_line(base);
+        memcpy(&line->data[offset], src, count);
+        line->dirty |= (count == 32 ? 0xFFFFFFFFUL : ((1UL << count) - 1)) << offset;
+        src += count;
+        pos += count;
+        len -= count;
+    }
+    cache_last_write = timer_read32();
+}
+
+void eeprom_driver_erase(void) {
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; ++i) {
+        cache_lines[i].dirty = 0;
+    }
+    eeprom_backend_erase();
+}
+
+void eeprom_driver_flush(void) {
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; ++i) {
+        if (cache_lines[i].dirty) {
+            eeprom_cache_flush_line(&cache_lines[i]);
+        }
+    }
+}
+
+void eeprom_driver_task(void) {
+    if (timer_elapsed32(cache_last_write) < EEPROM_WRITE_CACHE_IDLE_MS) {
+        return;
+    }
+    eeprom_driver_flush();
+}
+#endif // EEPROM_WRITE_CACHE_ENABLE
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
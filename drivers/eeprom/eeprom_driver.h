@@ -20,3 +20,20 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+// Backend accessors sitting behind the write cache -- see eeprom_backend.h
+void eeprom_backend_read_block(void *buf, const void *addr, size_t len);
+void eeprom_backend_write_block(const void *buf, void *addr, size_t len);
+void eeprom_backend_erase(void);
+
+/**
+ * Commits all writes held in the write cache to the backend.
+ */
+void eeprom_driver_flush(void);
+
+/**
+ * Commits held writes once the EEPROM has not been written to for EEPROM_WRITE_CACHE_IDLE_MS.
+ */
+void eeprom_driver_task(void);
+#endif // EEPROM_WRITE_CACHE_ENABLE
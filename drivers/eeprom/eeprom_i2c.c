@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #if defined(EXTERNAL_EEPROM_WP_PIN)
 #    include "gpio.h"
@@ -33,18 +34,28 @@
     there is nothing to override during linkage.
 */
 
-#include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
-#include "eeprom.h"
+#include "eeprom_backend.h"
 #include "eeprom_i2c.h"
 
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
+// Set once a page write has been sent, until the EEPROM has been seen to finish its write cycle
+static bool     write_pending = false;
+static uint16_t write_started;
+
+#if defined(EXTERNAL_EEPROM_READ_CACHE_ENABLE)
+// A copy of the most recently read page, kept in step with writes
+static uint8_t   cache_data[EXTERNAL_EEPROM_PAGE_SIZE];
+static uintptr_t cache_page  = 0;
+static bool      cache_valid = false;
+#endif // EXTERNAL_EEPROM_READ_CACHE_ENABLE
+
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
@@ -53,6 +64,39 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+/*
+    Sends a packet to the EEPROM, waiting for any previous write cycle to finish first.
+
+    Rather than sleeping for the worst-case write time after every page write,
+    the write cycle is left to run in the background. While it is in progress
+    the EEPROM does not acknowledge its address, so the next transfer is simply
+    retried until it is accepted -- or until EXTERNAL_EEPROM_WRITE_TIME has
+    passed, at which point the EEPROM should have finished regardless.
+*/
+static i2c_status_t transmit_when_ready(uintptr_t addr, const uint8_t *data, uint16_t length) {
+    while (EXTERNAL_EEPROM_WRITE_TIME > 0 && write_pending) {
+        i2c_status_t status = i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), data, length, 100);
+        if (status == I2C_STATUS_SUCCESS) {
+            write_pending = false;
+            return status;
+        }
+        if (timer_elapsed(write_started) > EXTERNAL_EEPROM_WRITE_TIME) {
+            write_pending = false;
+        }
+    }
+    return i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), data, length, 100);
+}
+
+static bool read_direct(void *buf, uintptr_t addr, size_t len) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, (const void *)addr);
+
+    if (transmit_when_ready(addr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE) != I2C_STATUS_SUCCESS) {
+        return false;
+    }
+    return i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS(addr), buf, len, 100) == I2C_STATUS_SUCCESS;
+}
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -79,11 +123,37 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
-    fill_target_address(complete_packet, addr);
-
-    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
-    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+#if defined(EXTERNAL_EEPROM_READ_CACHE_ENABLE)
+    // Small reads, such as individual keycode or eeconfig lookups, are served from a copy of the page they fall in.
+    // On a miss the whole page is fetched, so that neighbouring reads no longer need to touch the bus. Larger reads
+    // gain nothing from the cache, and are made in a single transfer instead.
+    if (len < EXTERNAL_EEPROM_PAGE_SIZE) {
+        uint8_t * write_buf   = (uint8_t *)buf;
+        uintptr_t target_addr = (uintptr_t)addr;
+        size_t    remaining   = len;
+        while (remaining > 0) {
+            uintptr_t page_offset = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
+            uintptr_t page        = target_addr - page_offset;
+            size_t    read_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
+            if (read_length > remaining) {
+                read_length = remaining;
+            }
+
+            if (!cache_valid || cache_page != page) {
+                cache_valid = read_direct(cache_data, page, EXTERNAL_EEPROM_PAGE_SIZE);
+                cache_page  = page;
+            }
+            memcpy(write_buf, &cache_data[page_offset], read_length);
+
+            write_buf += read_length;
+            target_addr += read_length;
+            remaining -= read_length;
+        }
+    } else
+#endif // EXTERNAL_EEPROM_READ_CACHE_ENABLE
+    {
+        read_direct(buf, (uintptr_t)addr, len);
+    }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
@@ -124,8 +194,19 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        bool written = transmit_when_ready(target_addr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length) == I2C_STATUS_SUCCESS;
+        write_pending = written;
+        write_started = timer_read();
+
+#if defined(EXTERNAL_EEPROM_READ_CACHE_ENABLE)
+        if (cache_valid && cache_page == target_addr - page_offset) {
+            if (written) {
+                memcpy(&cache_data[page_offset], read_buf, write_length);
+            } else {
+                cache_valid = false;
+            }
+        }
+#endif // EXTERNAL_EEPROM_READ_CACHE_ENABLE
 
         read_buf += write_length;
         target_addr += write_length;
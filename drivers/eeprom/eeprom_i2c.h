@@ -118,7 +118,8 @@
 
 /*
     The write cycle time of the EEPROM in milliseconds, as specified in the
-    datasheet.
+    datasheet. The EEPROM is polled for completion after each page write, so
+    this is only the upper bound on how long the driver will wait.
 */
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
@@ -162,131 +162,281 @@ static flash_status_t spi_flash_transaction(uint8_t cmd, uint32_t addr, uint8_t
     return response;
 }
 
-void flash_init(void) {
-    spi_init();
-}
+/*
+    State of the background erase or program operation. Only one operation
+    is in flight at a time; starting another waits for the previous one.
+*/
+typedef enum {
+    FLASH_ASYNC_IDLE,
+    FLASH_ASYNC_ERASE,
+    FLASH_ASYNC_PROGRAM,
+} flash_async_op_t;
+
+static struct {
+    flash_async_op_t       op;
+    uint32_t               addr;
+    const uint8_t *        data;
+    size_t                 remaining;
+    uint32_t               started;
+    flash_async_callback_t callback;
+    void *                 cb_arg;
+    flash_status_t         error; // first failure of a background operation, until collected by flash_async_error()
+} flash_async = {0};
+
+static flash_status_t spi_flash_read_status(uint8_t *status) {
+    bool res = spi_flash_start();
+    if (!res) {
+        // The bus is in use by another device, the FLASH is left to carry on with whatever it is doing
+        return FLASH_STATUS_BUSY;
+    }
 
-flash_status_t flash_erase_chip(void) {
-    flash_status_t response = FLASH_STATUS_SUCCESS;
+    spi_write(FLASH_CMD_RDSR);
 
-    /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase chip]\n");
-        return response;
+    *status = (uint8_t)spi_read();
+
+    spi_stop();
+
+    return FLASH_STATUS_SUCCESS;
+}
+
+/* Issues the page program for the next part of the pending write, up to the end of the page it starts in. */
+static flash_status_t spi_flash_program_next_page(void) {
+    flash_status_t response     = FLASH_STATUS_SUCCESS;
+    uint32_t       page_offset  = flash_async.addr % EXTERNAL_FLASH_PAGE_SIZE;
+    size_t         write_length = EXTERNAL_FLASH_PAGE_SIZE - page_offset;
+    if (write_length > flash_async.remaining) {
+        write_length = flash_async.remaining;
     }
 
     /* Enable writes. */
     response = spi_flash_write_enable();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase chip]\n");
+        dprint("Failed to write-enable! [spi flash write block]\n");
         return response;
     }
 
-    /* Erase Chip. */
-    bool res = spi_flash_start();
-    if (!res) {
-        dprint("Failed to start SPI! [spi flash erase chip]\n");
-        return FLASH_STATUS_ERROR;
+#if defined(CONSOLE_ENABLE) && defined(DEBUG_FLASH_SPI_OUTPUT)
+    dprintf("[SPI FLASH W] 0x%08lx: ", flash_async.addr);
+    for (size_t i = 0; i < write_length; i++) {
+        dprintf(" %02X", (int)(uint8_t)(flash_async.data[i]));
     }
-    spi_write(FLASH_CMD_CE);
-    spi_stop();
+    dprintf("\n");
+#endif // DEBUG_FLASH_SPI_OUTPUT
 
-    /* Wait for the write-in-progress bit to be cleared.*/
-    response = spi_flash_wait_while_busy();
+    /* Perform the write. */
+    response = spi_flash_transaction(FLASH_CMD_PP, flash_async.addr, (uint8_t *)flash_async.data, write_length);
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase chip]\n");
+        dprint("Failed to write block! [spi flash write block]\n");
         return response;
     }
 
+    flash_async.data += write_length;
+    flash_async.addr += write_length;
+    flash_async.remaining -= write_length;
+    flash_async.started = timer_read32();
+
     return response;
 }
 
-flash_status_t flash_erase_sector(uint32_t addr) {
-    flash_status_t response = FLASH_STATUS_SUCCESS;
+static flash_status_t spi_flash_async_finish(flash_status_t status) {
+    flash_async_callback_t callback = flash_async.callback;
+    void *                 cb_arg   = flash_async.cb_arg;
 
-    /* Check that the address exceeds the limit. */
-    if ((addr + (EXTERNAL_FLASH_SECTOR_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_SECTOR_SIZE)) != 0)) {
-        dprintf("Flash erase sector address over limit! [addr:0x%lx]\n", (uint32_t)addr);
-        return FLASH_STATUS_ERROR;
+    flash_async.op       = FLASH_ASYNC_IDLE;
+    flash_async.callback = NULL;
+    flash_async.cb_arg   = NULL;
+    if (status != FLASH_STATUS_SUCCESS && flash_async.error == FLASH_STATUS_SUCCESS) {
+        flash_async.error = status;
     }
 
-    /* Wait for the write-in-progress bit to be cleared. */
+    if (callback) {
+        callback(status, cb_arg);
+    }
+    return status;
+}
+
+/* Sends a write-enabled erase command, leaving the erase to complete in the background. */
+static flash_status_t spi_flash_start_erase(uint8_t cmd, uint32_t addr) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
+
+    /* Complete any previous operation, and wait for the write-in-progress bit to be cleared. */
+    response = flash_async_wait();
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Previous operation failed! [spi flash erase]\n");
+        return response;
+    }
     response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase sector]\n");
+        dprint("Failed to check WIP flag! [spi flash erase]\n");
         return response;
     }
 
     /* Enable writes. */
     response = spi_flash_write_enable();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase sector]\n");
+        dprint("Failed to write-enable! [spi flash erase]\n");
         return response;
     }
 
-    /* Erase Sector. */
-    response = spi_flash_transaction(FLASH_CMD_SE, addr, NULL, 0);
+    /* Erase. */
+    response = spi_flash_transaction(cmd, addr, NULL, 0);
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to erase sector! [spi flash erase sector]\n");
+        dprint("Failed to erase! [spi flash erase]\n");
         return response;
     }
 
-    /* Wait for the write-in-progress bit to be cleared.*/
-    response = spi_flash_wait_while_busy();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase sector]\n");
-        return response;
-    }
+    flash_async.op      = FLASH_ASYNC_ERASE;
+    flash_async.addr    = addr;
+    flash_async.started = timer_read32();
 
     return response;
 }
 
-flash_status_t flash_erase_block(uint32_t addr) {
+void flash_init(void) {
+    spi_init();
+}
+
+flash_status_t flash_task(void) {
     flash_status_t response = FLASH_STATUS_SUCCESS;
+    uint8_t        status;
 
-    /* Check that the address exceeds the limit. */
-    if ((addr + (EXTERNAL_FLASH_BLOCK_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_BLOCK_SIZE)) != 0)) {
-        dprintf("Flash erase block address over limit! [addr:0x%lx]\n", (uint32_t)addr);
-        return FLASH_STATUS_ERROR;
+    if (flash_async.op == FLASH_ASYNC_IDLE) {
+        return FLASH_STATUS_SUCCESS;
+    }
+
+    response = spi_flash_read_status(&status);
+    if (response == FLASH_STATUS_BUSY || (status & FLASH_FLAG_WIP)) {
+        if (timer_elapsed32(flash_async.started) >= EXTERNAL_FLASH_SPI_TIMEOUT) {
+            dprint("Timed out waiting for WIP flag! [spi flash task]\n");
+            return spi_flash_async_finish(FLASH_STATUS_TIMEOUT);
+        }
+        return FLASH_STATUS_BUSY;
     }
 
-    /* Wait for the write-in-progress bit to be cleared. */
+    if (flash_async.op == FLASH_ASYNC_PROGRAM) {
+        /* Move on to the next page, if there is one. */
+        if (flash_async.remaining > 0) {
+            response = spi_flash_program_next_page();
+            if (response != FLASH_STATUS_SUCCESS) {
+                return spi_flash_async_finish(response);
+            }
+            return FLASH_STATUS_BUSY;
+        }
+
+        /* Disable writes. */
+        response = spi_flash_write_disable();
+        if (response != FLASH_STATUS_SUCCESS) {
+            dprint("Failed to write-disable! [spi flash task]\n");
+        }
+    }
+
+    return spi_flash_async_finish(response);
+}
+
+flash_status_t flash_async_wait(void) {
+    flash_status_t response;
+    do {
+        response = flash_task();
+    } while (response == FLASH_STATUS_BUSY);
+    return response;
+}
+
+flash_status_t flash_async_error(void) {
+    flash_status_t error = flash_async.error;
+    flash_async.error    = FLASH_STATUS_SUCCESS;
+    return error;
+}
+
+void flash_async_notify(flash_async_callback_t callback, void *cb_arg) {
+    if (flash_async.op == FLASH_ASYNC_IDLE) {
+        if (callback) {
+            callback(FLASH_STATUS_SUCCESS, cb_arg);
+        }
+        return;
+    }
+    flash_async.callback = callback;
+    flash_async.cb_arg   = cb_arg;
+}
+
+flash_status_t flash_erase_chip(void) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
+
+    /* Complete any previous operation, and wait for the write-in-progress bit to be cleared. */
+    flash_async_wait();
     response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase block]\n");
+        dprint("Failed to check WIP flag! [spi flash erase chip]\n");
         return response;
     }
 
     /* Enable writes. */
     response = spi_flash_write_enable();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase block]\n");
+        dprint("Failed to write-enable! [spi flash erase chip]\n");
         return response;
     }
 
-    /* Erase Block. */
-    response = spi_flash_transaction(FLASH_CMD_BE, addr, NULL, 0);
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to erase block! [spi flash erase block]\n");
-        return response;
+    /* Erase Chip. */
+    bool res = spi_flash_start();
+    if (!res) {
+        dprint("Failed to start SPI! [spi flash erase chip]\n");
+        return FLASH_STATUS_ERROR;
     }
+    spi_write(FLASH_CMD_CE);
+    spi_stop();
 
     /* Wait for the write-in-progress bit to be cleared.*/
     response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase block]\n");
+        dprint("Failed to check WIP flag! [spi flash erase chip]\n");
         return response;
     }
 
     return response;
 }
 
+flash_status_t flash_erase_sector_async(uint32_t addr) {
+    /* Check that the address exceeds the limit. */
+    if ((addr + (EXTERNAL_FLASH_SECTOR_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_SECTOR_SIZE)) != 0)) {
+        dprintf("Flash erase sector address over limit! [addr:0x%lx]\n", (uint32_t)addr);
+        return FLASH_STATUS_ERROR;
+    }
+
+    return spi_flash_start_erase(FLASH_CMD_SE, addr);
+}
+
+flash_status_t flash_erase_sector(uint32_t addr) {
+    flash_status_t response = flash_erase_sector_async(addr);
+    if (response != FLASH_STATUS_SUCCESS) {
+        return response;
+    }
+    return flash_async_wait();
+}
+
+flash_status_t flash_erase_block_async(uint32_t addr) {
+    /* Check that the address exceeds the limit. */
+    if ((addr + (EXTERNAL_FLASH_BLOCK_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_BLOCK_SIZE)) != 0)) {
+        dprintf("Flash erase block address over limit! [addr:0x%lx]\n", (uint32_t)addr);
+        return FLASH_STATUS_ERROR;
+    }
+
+    return spi_flash_start_erase(FLASH_CMD_BE, addr);
+}
+
+flash_status_t flash_erase_block(uint32_t addr) {
+    flash_status_t response = flash_erase_block_async(addr);
+    if (response != FLASH_STATUS_SUCCESS) {
+        return response;
+    }
+    return flash_async_wait();
+}
+
 flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
     flash_status_t response = FLASH_STATUS_SUCCESS;
     uint8_t *      read_buf = (uint8_t *)buf;
 
-    /* Wait for the write-in-progress bit to be cleared. */
+    /* Complete any previous operation, and wait for the write-in-progress bit to be cleared. */
+    flash_async_wait();
     response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash read block]\n");
@@ -313,64 +463,42 @@ flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
     return response;
 }
 
-flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len) {
-    flash_status_t response  = FLASH_STATUS_SUCCESS;
-    uint8_t *      write_buf = (uint8_t *)buf;
-
-    while (len > 0) {
-        uint32_t page_offset  = addr % EXTERNAL_FLASH_PAGE_SIZE;
-        size_t   write_length = EXTERNAL_FLASH_PAGE_SIZE - page_offset;
-        if (write_length > len) {
-            write_length = len;
-        }
-
-        /* Wait for the write-in-progress bit to be cleared. */
-        response = spi_flash_wait_while_busy();
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to check WIP flag! [spi flash write block]\n");
-            return response;
-        }
-
-        /* Enable writes. */
-        response = spi_flash_write_enable();
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to write-enable! [spi flash write block]\n");
-            return response;
-        }
-
-#if defined(CONSOLE_ENABLE) && defined(DEBUG_FLASH_SPI_OUTPUT)
-        dprintf("[SPI FLASH W] 0x%08lx: ", addr);
-        for (size_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(uint8_t)(write_buf[i]));
-        }
-        dprintf("\n");
-#endif // DEBUG_FLASH_SPI_OUTPUT
-
-        /* Perform the write. */
-        response = spi_flash_transaction(FLASH_CMD_PP, addr, write_buf, write_length);
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to write block! [spi flash write block]\n");
-            return response;
-        }
+flash_status_t flash_write_block_async(uint32_t addr, const void *buf, size_t len) {
+    flash_status_t response = FLASH_STATUS_SUCCESS;
 
-        write_buf += write_length;
-        addr += write_length;
-        len -= write_length;
+    /* Complete any previous operation, and wait for the write-in-progress bit to be cleared. */
+    response = flash_async_wait();
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Previous operation failed! [spi flash write block]\n");
+        return response;
     }
-
-    /* Wait for the write-in-progress bit to be cleared. */
     response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash write block]\n");
         return response;
     }
 
-    /* Disable writes. */
-    response = spi_flash_write_disable();
+    if (len == 0) {
+        return response;
+    }
+
+    /* Program the first page now, the rest are programmed from flash_task() as each completes. */
+    flash_async.addr      = addr;
+    flash_async.data      = (const uint8_t *)buf;
+    flash_async.remaining = len;
+    response              = spi_flash_program_next_page();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-disable! [spi flash write block]\n");
         return response;
     }
 
+    flash_async.op = FLASH_ASYNC_PROGRAM;
     return response;
 }
+
+flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len) {
+    flash_status_t response = flash_write_block_async(addr, buf, len);
+    if (response != FLASH_STATUS_SUCCESS) {
+        return response;
+    }
+    return flash_async_wait();
+}
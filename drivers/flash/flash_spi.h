@@ -112,6 +112,9 @@ typedef int16_t flash_status_t;
 #define FLASH_STATUS_ERROR (-1)
 #define FLASH_STATUS_TIMEOUT (-2)
 #define FLASH_STATUS_BAD_ADDRESS (-3)
+#define FLASH_STATUS_BUSY (-4)
+
+typedef void (*flash_async_callback_t)(flash_status_t status, void *cb_arg);
 
 #ifdef __cplusplus
 extern "C" {
@@ -131,6 +134,37 @@ flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len);
 
 flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len);
 
+/*
+    Asynchronous erase and program.
+
+    These start the operation and return without waiting for the FLASH to
+    complete it. Writes spanning multiple pages are programmed one page at a
+    time, with each following page issued from flash_task() once the previous
+    one has completed -- the buffer must remain valid until then.
+
+    flash_task() returns FLASH_STATUS_BUSY while an operation is in progress,
+    including while the SPI bus is in use by another device, and should be
+    called regularly from the main loop. Starting any other operation,
+    including a read, waits for the in-progress one to complete -- erases and
+    writes fail if it did not complete successfully.
+
+    The first failure of an operation completed in the background is kept
+    until collected by flash_async_error(), whichever call completed it.
+*/
+flash_status_t flash_erase_block_async(uint32_t addr);
+
+flash_status_t flash_erase_sector_async(uint32_t addr);
+
+flash_status_t flash_write_block_async(uint32_t addr, const void *buf, size_t len);
+
+flash_status_t flash_task(void);
+
+flash_status_t flash_async_wait(void);
+
+flash_status_t flash_async_error(void);
+
+void flash_async_notify(flash_async_callback_t callback, void *cb_arg); // invoked from flash_task() on completion, or immediately if idle
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <string.h>
 #include "progmem.h"
 #include "wait.h"
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+#    include "keyboard.h"
+#endif
 
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
@@ -143,6 +146,25 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 uint8_t         oled_buffer[OLED_MATRIX_SIZE];
 uint8_t *       oled_cursor;
 OLED_BLOCK_TYPE oled_dirty          = 0;
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+uint8_t         oled_slave_buffer[OLED_MATRIX_SIZE];
+OLED_BLOCK_TYPE oled_slave_dirty = 0;
+// The drawing functions write to whichever framebuffer these point at, which is the slave's while
+// oled_task_slave_kb() is running
+static uint8_t *        oled_draw_buffer = oled_buffer;
+static OLED_BLOCK_TYPE *oled_draw_dirty  = &oled_dirty;
+#    define OLED_DRAW_BUFFER oled_draw_buffer
+#    define OLED_DRAW_DIRTY (*oled_draw_dirty)
+#else
+#    define OLED_DRAW_BUFFER oled_buffer
+#    define OLED_DRAW_DIRTY oled_dirty
+#endif
+#ifdef OLED_SKIP_UNCHANGED_BLOCKS
+// Copy of what was last sent to the display, so blocks rewritten with identical content can be skipped. Only blocks
+// flagged in oled_rendered_valid are known to match the display's memory.
+static uint8_t         oled_rendered[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_rendered_valid = 0;
+#endif
 bool            oled_initialized    = false;
 bool            oled_active         = false;
 bool            oled_scrolling      = false;
@@ -364,7 +386,15 @@ bool oled_init(oled_rotation_t rotation) {
     oled_scroll_timeout = timer_read32() + OLED_SCROLL_TIMEOUT;
 #endif
 
+    // The display's memory is undefined after power on, so everything needs to be sent regardless of content
     oled_clear();
+    oled_dirty = OLED_ALL_BLOCKS_MASK;
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+    oled_slave_dirty = OLED_ALL_BLOCKS_MASK;
+#endif
+#ifdef OLED_SKIP_UNCHANGED_BLOCKS
+    oled_rendered_valid = 0;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -379,12 +409,21 @@ __attribute__((weak)) oled_rotation_t oled_init_user(oled_rotation_t rotation) {
 }
 
 void oled_clear(void) {
-    memset(oled_buffer, 0, sizeof(oled_buffer));
-    oled_cursor = &oled_buffer[0];
-    oled_dirty  = OLED_ALL_BLOCKS_MASK;
+    // Only blocks which actually had content need to be sent again
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        const uint8_t *block = &OLED_DRAW_BUFFER[OLED_BLOCK_SIZE * i];
+        for (uint16_t j = 0; j < OLED_BLOCK_SIZE; ++j) {
+            if (block[j]) {
+                OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << i);
+                break;
+            }
+        }
+    }
+    memset(OLED_DRAW_BUFFER, 0, OLED_MATRIX_SIZE);
+    oled_cursor = &OLED_DRAW_BUFFER[0];
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
+static void calc_bounds(uint8_t update_start, uint16_t length, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
     uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
     uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
@@ -395,11 +434,33 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
     cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
 #else
-    // Commands for use in Horizontal Addressing mode.
+    // Commands for use in Horizontal Addressing mode. Ranges spanning multiple pages must start at the first column, as
+    // the controller wraps back to the start column at the end of each page.
     cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
     cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+    if (start_column + length > OLED_DISPLAY_WIDTH) {
+        cmd_array[2] = OLED_DISPLAY_WIDTH - 1 + OLED_COLUMN_OFFSET;
+        cmd_array[5] = (length + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+    } else {
+        cmd_array[2] = length - 1 + cmd_array[1];
+        cmd_array[5] = cmd_array[4];
+    }
+#endif
+}
+
+// Whether the blocks from update_start through update_end can be written with a single set of addressing bounds.
+static bool can_coalesce(uint8_t update_start, uint8_t update_end) {
+    uint16_t start = OLED_BLOCK_SIZE * update_start;
+    uint16_t end   = OLED_BLOCK_SIZE * (update_end + 1) - 1;
+    if (start / OLED_DISPLAY_WIDTH == end / OLED_DISPLAY_WIDTH) {
+        return true;
+    }
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    // Wrapping onto the next page returns to the start column, so only whole pages can be spanned
+    return start % OLED_DISPLAY_WIDTH == 0;
+#else
+    // Page Addressing Mode never advances to the next page
+    return false;
 #endif
 }
 
@@ -455,17 +516,52 @@ void oled_render(void) {
         return;
     }
 
+#ifdef OLED_SKIP_UNCHANGED_BLOCKS
+    // Drop any blocks that were rewritten with what the display is already showing
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        OLED_BLOCK_TYPE block_mask = (OLED_BLOCK_TYPE)1 << i;
+        if ((oled_dirty & oled_rendered_valid & block_mask) && memcmp(&oled_buffer[OLED_BLOCK_SIZE * i], &oled_rendered[OLED_BLOCK_SIZE * i], OLED_BLOCK_SIZE) == 0) {
+            oled_dirty &= ~block_mask;
+        }
+    }
+    if (!oled_dirty) {
+        return;
+    }
+#endif
+
     // Turn on display if it is off
     oled_on();
 
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && num_processed++ < OLED_UPDATE_PROCESS_LIMIT) { // render all dirty blocks (up to the configured limit)
+    while (oled_dirty && num_processed < OLED_UPDATE_PROCESS_LIMIT) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
         }
 
+        // Blocks that are adjacent in the display's memory are sent as a single transfer. Rotated blocks never are, so
+        // are always sent one at a time.
+        uint8_t num_blocks = 1;
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+#if defined(OLED_RENDER_SINGLE_TRANSFER) && OLED_IC_HAS_HORIZONTAL_MODE
+            // Send everything up to the last dirty block, including any unchanged blocks in between
+            uint8_t update_end = OLED_BLOCK_COUNT - 1;
+            while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_end))) {
+                --update_end;
+            }
+            if (!can_coalesce(update_start, update_end)) {
+                update_start = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH * OLED_DISPLAY_WIDTH / OLED_BLOCK_SIZE;
+            }
+            num_blocks = update_end - update_start + 1;
+#else
+            while (num_processed + num_blocks < OLED_UPDATE_PROCESS_LIMIT && update_start + num_blocks < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << (update_start + num_blocks))) && can_coalesce(update_start, update_start + num_blocks)) {
+                ++num_blocks;
+            }
+#endif
+        }
+        num_processed += num_blocks;
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
@@ -473,7 +569,7 @@ void oled_render(void) {
         static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+            calc_bounds(update_start, OLED_BLOCK_SIZE * num_blocks, &display_start[1]); // Offset from I2C_CMD byte at the start
         } else {
             calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
         }
@@ -486,7 +582,7 @@ void oled_render(void) {
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE * num_blocks)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -529,8 +625,16 @@ void oled_render(void) {
 #endif
         }
 
-        // Clear dirty flag of just rendered block
-        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        // Clear dirty flags of just rendered blocks
+        for (uint8_t i = update_start; i < update_start + num_blocks; ++i) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << i);
+#ifdef OLED_SKIP_UNCHANGED_BLOCKS
+            oled_rendered_valid |= ((OLED_BLOCK_TYPE)1 << i);
+#endif
+        }
+#ifdef OLED_SKIP_UNCHANGED_BLOCKS
+        memcpy(&oled_rendered[OLED_BLOCK_SIZE * update_start], &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE * num_blocks);
+#endif
     }
 }
 
@@ -542,11 +646,11 @@ void oled_set_cursor(uint8_t col, uint8_t line) {
         index = 0;
     }
 
-    oled_cursor = &oled_buffer[index];
+    oled_cursor = &OLED_DRAW_BUFFER[index];
 }
 
 void oled_advance_page(bool clearPageRemainder) {
-    uint16_t index     = oled_cursor - &oled_buffer[0];
+    uint16_t index     = oled_cursor - &OLED_DRAW_BUFFER[0];
     uint8_t  remaining = oled_rotation_width - (index % oled_rotation_width);
 
     if (clearPageRemainder) {
@@ -563,12 +667,12 @@ void oled_advance_page(bool clearPageRemainder) {
             remaining = 0;
         }
 
-        oled_cursor = &oled_buffer[index + remaining];
+        oled_cursor = &OLED_DRAW_BUFFER[index + remaining];
     }
 }
 
 void oled_advance_char(void) {
-    uint16_t nextIndex      = oled_cursor - &oled_buffer[0] + OLED_FONT_WIDTH;
+    uint16_t nextIndex      = oled_cursor - &OLED_DRAW_BUFFER[0] + OLED_FONT_WIDTH;
     uint8_t  remainingSpace = oled_rotation_width - (nextIndex % oled_rotation_width);
 
     // Do we have enough space on the current line for the next character
@@ -582,7 +686,7 @@ void oled_advance_char(void) {
     }
 
     // Update cursor position
-    oled_cursor = &oled_buffer[nextIndex];
+    oled_cursor = &OLED_DRAW_BUFFER[nextIndex];
 }
 
 // Main handler that writes character data to the display buffer
@@ -621,10 +725,10 @@ void oled_write_char(const char data, bool invert) {
 
     // Dirty check
     if (memcmp(&oled_temp_buffer, oled_cursor, OLED_FONT_WIDTH)) {
-        uint16_t index = oled_cursor - &oled_buffer[0];
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+        uint16_t index = oled_cursor - &OLED_DRAW_BUFFER[0];
+        OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
         // Edgecase check if the written data spans the 2 chunks
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << ((index + OLED_FONT_WIDTH - 1) / OLED_BLOCK_SIZE));
+        OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << ((index + OLED_FONT_WIDTH - 1) / OLED_BLOCK_SIZE));
     }
 
     // Finally move to the next char
@@ -649,42 +753,45 @@ void oled_pan(bool left) {
     for (uint16_t y = 0; y < OLED_DISPLAY_HEIGHT / 8; y++) {
         if (left) {
             for (uint16_t x = 0; x < OLED_DISPLAY_WIDTH - 1; x++) {
-                i              = y * OLED_DISPLAY_WIDTH + x;
-                oled_buffer[i] = oled_buffer[i + 1];
+                i = y * OLED_DISPLAY_WIDTH + x;
+                if (OLED_DRAW_BUFFER[i] == OLED_DRAW_BUFFER[i + 1]) continue;
+                OLED_DRAW_BUFFER[i] = OLED_DRAW_BUFFER[i + 1];
+                OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
             }
         } else {
             for (uint16_t x = OLED_DISPLAY_WIDTH - 1; x > 0; x--) {
-                i              = y * OLED_DISPLAY_WIDTH + x;
-                oled_buffer[i] = oled_buffer[i - 1];
+                i = y * OLED_DISPLAY_WIDTH + x;
+                if (OLED_DRAW_BUFFER[i] == OLED_DRAW_BUFFER[i - 1]) continue;
+                OLED_DRAW_BUFFER[i] = OLED_DRAW_BUFFER[i - 1];
+                OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
             }
         }
     }
-    oled_dirty = OLED_ALL_BLOCKS_MASK;
 }
 
 oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
     if (start_index > OLED_MATRIX_SIZE) start_index = OLED_MATRIX_SIZE;
     oled_buffer_reader_t ret_reader;
-    ret_reader.current_element         = &oled_buffer[start_index];
+    ret_reader.current_element         = &OLED_DRAW_BUFFER[start_index];
     ret_reader.remaining_element_count = OLED_MATRIX_SIZE - start_index;
     return ret_reader;
 }
 
 void oled_write_raw_byte(const char data, uint16_t index) {
-    if (index > OLED_MATRIX_SIZE) index = OLED_MATRIX_SIZE;
-    if (oled_buffer[index] == data) return;
-    oled_buffer[index] = data;
-    oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+    if (index >= OLED_MATRIX_SIZE) return;
+    if (OLED_DRAW_BUFFER[index] == data) return;
+    OLED_DRAW_BUFFER[index] = data;
+    OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
 }
 
 void oled_write_raw(const char *data, uint16_t size) {
-    uint16_t cursor_start_index = oled_cursor - &oled_buffer[0];
+    uint16_t cursor_start_index = oled_cursor - &OLED_DRAW_BUFFER[0];
     if ((size + cursor_start_index) > OLED_MATRIX_SIZE) size = OLED_MATRIX_SIZE - cursor_start_index;
     for (uint16_t i = cursor_start_index; i < cursor_start_index + size; i++) {
         uint8_t c = *data++;
-        if (oled_buffer[i] == c) continue;
-        oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        if (OLED_DRAW_BUFFER[i] == c) continue;
+        OLED_DRAW_BUFFER[i] = c;
+        OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
     }
 }
 
@@ -696,15 +803,15 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     if (index >= OLED_MATRIX_SIZE) {
         return;
     }
-    uint8_t data = oled_buffer[index];
+    uint8_t data = OLED_DRAW_BUFFER[index];
     if (on) {
         data |= (1 << (y % 8));
     } else {
         data &= ~(1 << (y % 8));
     }
-    if (oled_buffer[index] != data) {
-        oled_buffer[index] = data;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+    if (OLED_DRAW_BUFFER[index] != data) {
+        OLED_DRAW_BUFFER[index] = data;
+        OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
     }
 }
 
@@ -723,13 +830,13 @@ void oled_write_ln_P(const char *data, bool invert) {
 }
 
 void oled_write_raw_P(const char *data, uint16_t size) {
-    uint16_t cursor_start_index = oled_cursor - &oled_buffer[0];
+    uint16_t cursor_start_index = oled_cursor - &OLED_DRAW_BUFFER[0];
     if ((size + cursor_start_index) > OLED_MATRIX_SIZE) size = OLED_MATRIX_SIZE - cursor_start_index;
     for (uint16_t i = cursor_start_index; i < cursor_start_index + size; i++) {
         uint8_t c = pgm_read_byte(data++);
-        if (oled_buffer[i] == c) continue;
-        oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        if (OLED_DRAW_BUFFER[i] == c) continue;
+        OLED_DRAW_BUFFER[i] = c;
+        OLED_DRAW_DIRTY |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
     }
 }
 #endif // defined(__AVR__)
@@ -880,6 +987,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_SKIP_UNCHANGED_BLOCKS
+        // Scrolling moves the contents of the display's memory, so none of it can be assumed to match any more
+        oled_rendered_valid = 0;
+#endif
     }
     return !oled_scrolling;
 }
@@ -926,6 +1037,33 @@ uint8_t oled_max_lines(void) {
     return OLED_DISPLAY_WIDTH / OLED_FONT_HEIGHT;
 }
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+// Points the drawing functions at the local or slave framebuffer, keeping the cursor at the same position
+static void oled_set_draw_target(uint8_t *buffer, OLED_BLOCK_TYPE *dirty) {
+    oled_cursor      = buffer + (oled_cursor - oled_draw_buffer);
+    oled_draw_buffer = buffer;
+    oled_draw_dirty  = dirty;
+}
+#endif
+
+static void oled_task_render(void) {
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+    // The slave's display is rendered by the master, and only receives its framebuffer over the split link
+    if (!is_keyboard_master()) {
+        return;
+    }
+    oled_set_cursor(0, 0);
+    oled_task_kb();
+    oled_set_draw_target(oled_slave_buffer, &oled_slave_dirty);
+    oled_set_cursor(0, 0);
+    oled_task_slave_kb();
+    oled_set_draw_target(oled_buffer, &oled_dirty);
+#else
+    oled_set_cursor(0, 0);
+    oled_task_kb();
+#endif
+}
+
 void oled_task(void) {
     if (!oled_initialized) {
         return;
@@ -934,12 +1072,10 @@ void oled_task(void) {
 #if OLED_UPDATE_INTERVAL > 0
     if (timer_elapsed(oled_update_timeout) >= OLED_UPDATE_INTERVAL) {
         oled_update_timeout = timer_read();
-        oled_set_cursor(0, 0);
-        oled_task_kb();
+        oled_task_render();
     }
 #else
-    oled_set_cursor(0, 0);
-    oled_task_kb();
+    oled_task_render();
 #endif
 
 #if OLED_SCROLL_TIMEOUT > 0
@@ -976,3 +1112,12 @@ __attribute__((weak)) bool oled_task_kb(void) {
 __attribute__((weak)) bool oled_task_user(void) {
     return true;
 }
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+__attribute__((weak)) bool oled_task_slave_kb(void) {
+    return oled_task_slave_user();
+}
+__attribute__((weak)) bool oled_task_slave_user(void) {
+    return true;
+}
+#endif
@@ -446,6 +446,17 @@ void oled_task(void);
 bool oled_task_kb(void);
 bool oled_task_user(void);
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+// Called on the master after oled_task_kb, to render the slave's display. All drawing functions target the slave's
+// framebuffer while it runs, which is then sent over the split link. oled_task_kb is not called on the slave.
+bool oled_task_slave_kb(void);
+bool oled_task_slave_user(void);
+
+// The master's copy of the slave's framebuffer, and the blocks that still need to be sent to the slave
+extern uint8_t         oled_slave_buffer[OLED_MATRIX_SIZE];
+extern OLED_BLOCK_TYPE oled_slave_dirty;
+#endif
+
 // Set the specific 8 lines rows of the screen to scroll.
 // 0 is the default for start, and 7 for end, which is the entire
 // height of the screen.  For 128x32 screens, rows 4-7 are not used.
@@ -9,6 +9,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
+// Waits for any in-flight asynchronous transfer to complete
+static inline void qp_comms_spi_wait(void) {
+#    ifdef QP_COMMS_SPI_ASYNC
+    while (spi_async_busy()) {
+    }
+#    endif
+}
+
 bool qp_comms_spi_init(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
@@ -35,6 +43,7 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     const uint8_t *p               = (const uint8_t *)data;
     const uint32_t max_msg_length  = 1024;
 
+    qp_comms_spi_wait();
     while (bytes_remaining > 0) {
         uint32_t bytes_this_loop = QP_MIN(bytes_remaining, max_msg_length);
         spi_transmit(p, bytes_this_loop);
@@ -45,18 +54,41 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+#    ifdef QP_COMMS_SPI_ASYNC
+uint32_t qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    // The whole buffer is left in flight, with larger transfers chained by the SPI driver's completion interrupt
+    return spi_transmit_async((const uint8_t *)data, byte_count) == SPI_STATUS_SUCCESS ? byte_count : 0;
+}
+
+bool qp_comms_spi_notify(painter_device_t device, painter_comms_notify_callback callback, void *cb_arg) {
+    spi_async_notify(callback, cb_arg);
+    return true;
+}
+
+void qp_comms_spi_release(painter_device_t device) {
+    // Chip select is raised by the SPI driver's completion interrupt once the in-flight transfer finishes
+    spi_stop_async();
+}
+#    endif // QP_COMMS_SPI_ASYNC
+
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
+    qp_comms_spi_wait();
     spi_stop();
     writePinHigh(comms_config->chip_select_pin);
 }
 
 const painter_comms_vtable_t spi_comms_vtable = {
-    .comms_init  = qp_comms_spi_init,
-    .comms_start = qp_comms_spi_start,
-    .comms_send  = qp_comms_spi_send_data,
-    .comms_stop  = qp_comms_spi_stop,
+    .comms_init       = qp_comms_spi_init,
+    .comms_start      = qp_comms_spi_start,
+    .comms_send       = qp_comms_spi_send_data,
+    .comms_stop       = qp_comms_spi_stop,
+#    ifdef QP_COMMS_SPI_ASYNC
+    .comms_send_async = qp_comms_spi_send_data_async,
+    .comms_notify     = qp_comms_spi_notify,
+    .comms_release    = qp_comms_spi_release,
+#    endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,13 +125,25 @@ bool qp_comms_spi_dc_reset_init(painter_device_t device) {
 uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    qp_comms_spi_wait();
     writePinHigh(comms_config->dc_pin);
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+#        ifdef QP_COMMS_SPI_ASYNC
+uint32_t qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    qp_comms_spi_wait();
+    writePinHigh(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count);
+}
+#        endif // QP_COMMS_SPI_ASYNC
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    qp_comms_spi_wait();
     writePinLow(comms_config->dc_pin);
     spi_write(cmd);
 }
@@ -123,10 +167,15 @@ void qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const
 const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
     .base =
         {
-            .comms_init  = qp_comms_spi_dc_reset_init,
-            .comms_start = qp_comms_spi_start,
-            .comms_send  = qp_comms_spi_dc_reset_send_data,
-            .comms_stop  = qp_comms_spi_stop,
+            .comms_init       = qp_comms_spi_dc_reset_init,
+            .comms_start      = qp_comms_spi_start,
+            .comms_send       = qp_comms_spi_dc_reset_send_data,
+            .comms_stop       = qp_comms_spi_stop,
+#        ifdef QP_COMMS_SPI_ASYNC
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+            .comms_notify     = qp_comms_spi_notify,
+            .comms_release    = qp_comms_spi_release,
+#        endif
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
@@ -10,6 +10,12 @@
 #    include "gpio.h"
 #    include "qp_internal.h"
 
+// Asynchronous transfers are only possible when the pixdata buffer is double-buffered, as the buffer being transmitted
+// must not be modified until the transfer is complete.
+#    if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER && defined(PROTOCOL_CHIBIOS)
+#        define QP_COMMS_SPI_ASYNC
+#    endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
@@ -25,6 +31,12 @@ bool     qp_comms_spi_start(painter_device_t device);
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void* data, uint32_t byte_count);
 void     qp_comms_spi_stop(painter_device_t device);
 
+#    ifdef QP_COMMS_SPI_ASYNC
+uint32_t qp_comms_spi_send_data_async(painter_device_t device, const void* data, uint32_t byte_count);
+bool     qp_comms_spi_notify(painter_device_t device, painter_comms_notify_callback callback, void* cb_arg);
+void     qp_comms_spi_release(painter_device_t device);
+#    endif // QP_COMMS_SPI_ASYNC
+
 extern const painter_comms_vtable_t spi_comms_vtable;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +54,10 @@ void     qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd
 uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void* data, uint32_t byte_count);
 void     qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const uint8_t* sequence, size_t sequence_len);
 
+#        ifdef QP_COMMS_SPI_ASYNC
+uint32_t qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void* data, uint32_t byte_count);
+#        endif // QP_COMMS_SPI_ASYNC
+
 extern const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable;
 
 #    endif // QUANTUM_PAINTER_SPI_DC_RESET_ENABLE
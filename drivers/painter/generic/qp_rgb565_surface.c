@@ -7,6 +7,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Common
 
+// Dirty region definition, inclusive coordinates
+typedef struct rgb565_surface_dirty_rect_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} rgb565_surface_dirty_rect_t;
+
 // Device definition
 typedef struct rgb565_surface_painter_device_t {
     painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
@@ -24,12 +32,10 @@ typedef struct rgb565_surface_painter_device_t {
     uint16_t pixdata_x;
     uint16_t pixdata_y;
 
-    // Maintain a dirty region so we can stream only what we need
-    bool     is_dirty;
-    uint16_t dirty_l;
-    uint16_t dirty_t;
-    uint16_t dirty_r;
-    uint16_t dirty_b;
+    // Maintain a set of dirty regions so we can stream only what we need
+    uint8_t                     dirty_count;
+    uint8_t                     dirty_last; // region most recently extended, checked first
+    rgb565_surface_dirty_rect_t dirty[RGB565_SURFACE_NUM_DIRTY_RECTS];
 
 } rgb565_surface_painter_device_t;
 
@@ -55,25 +61,94 @@ static inline void increment_pixdata_location(rgb565_surface_painter_device_t *s
     }
 }
 
-static inline void setpixel(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
-    // Skip messing with the dirty info if the original value already matches
-    if (surface->buffer[y * surface->base.panel_width + x] != rgb565) {
-        // Maintain dirty region
-        if (surface->dirty_l > x) {
-            surface->dirty_l = x;
-        }
-        if (surface->dirty_r < x) {
-            surface->dirty_r = x;
+static inline uint32_t dirty_rect_area(const rgb565_surface_dirty_rect_t *rect) {
+    return ((uint32_t)(rect->r - rect->l + 1)) * (rect->b - rect->t + 1);
+}
+
+static inline bool dirty_rect_contains(const rgb565_surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    return x >= rect->l && x <= rect->r && y >= rect->t && y <= rect->b;
+}
+
+// Checks if the two regions overlap or share an edge, in which case they're better off merged
+static inline bool dirty_rect_touches(const rgb565_surface_dirty_rect_t *a, const rgb565_surface_dirty_rect_t *b) {
+    return a->l <= b->r + 1 && b->l <= a->r + 1 && a->t <= b->b + 1 && b->t <= a->b + 1;
+}
+
+static inline void dirty_rect_union(rgb565_surface_dirty_rect_t *target, const rgb565_surface_dirty_rect_t *other) {
+    target->l = QP_MIN(target->l, other->l);
+    target->t = QP_MIN(target->t, other->t);
+    target->r = QP_MAX(target->r, other->r);
+    target->b = QP_MAX(target->b, other->b);
+}
+
+// Merges any regions touching the supplied region into it, removing them from the list
+static void coalesce_dirty_rects(rgb565_surface_painter_device_t *surface, uint8_t index) {
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < surface->dirty_count; ++i) {
+            if (i != index && dirty_rect_touches(&surface->dirty[index], &surface->dirty[i])) {
+                dirty_rect_union(&surface->dirty[index], &surface->dirty[i]);
+
+                // Move the last region into the vacated slot
+                surface->dirty_count--;
+                if (index == surface->dirty_count) {
+                    index = i;
+                }
+                surface->dirty[i] = surface->dirty[surface->dirty_count];
+                merged            = true;
+                break;
+            }
         }
-        if (surface->dirty_t > y) {
-            surface->dirty_t = y;
+    } while (merged);
+    surface->dirty_last = index;
+}
+
+static void mark_dirty(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y) {
+    rgb565_surface_dirty_rect_t pixel = {.l = x, .t = y, .r = x, .b = y};
+
+    // Fast path -- sequential drawing operations tend to hit the same region
+    if (surface->dirty_count > 0 && dirty_rect_contains(&surface->dirty[surface->dirty_last], x, y)) {
+        return;
+    }
+
+    // Work out which region is the cheapest to extend to cover the pixel, preferring regions adjacent to the pixel
+    uint8_t  best_index    = 0;
+    uint32_t best_cost     = UINT32_MAX;
+    bool     best_adjacent = false;
+    for (uint8_t i = 0; i < surface->dirty_count; ++i) {
+        if (dirty_rect_contains(&surface->dirty[i], x, y)) {
+            surface->dirty_last = i;
+            return;
         }
-        if (surface->dirty_b < y) {
-            surface->dirty_b = y;
+
+        rgb565_surface_dirty_rect_t extended = surface->dirty[i];
+        dirty_rect_union(&extended, &pixel);
+        uint32_t cost     = dirty_rect_area(&extended) - dirty_rect_area(&surface->dirty[i]);
+        bool     adjacent = dirty_rect_touches(&surface->dirty[i], &pixel);
+        if ((adjacent && !best_adjacent) || (adjacent == best_adjacent && cost < best_cost)) {
+            best_cost     = cost;
+            best_index    = i;
+            best_adjacent = adjacent;
         }
+    }
+
+    // Start a new region if the pixel isn't adjacent to an existing one and there's room, otherwise extend the cheapest
+    if (!best_adjacent && surface->dirty_count < RGB565_SURFACE_NUM_DIRTY_RECTS) {
+        surface->dirty[surface->dirty_count] = pixel;
+        surface->dirty_last                  = surface->dirty_count++;
+        return;
+    }
+
+    dirty_rect_union(&surface->dirty[best_index], &pixel);
+    coalesce_dirty_rects(surface, best_index);
+}
 
-        // Always dirty after a setpixel
-        surface->is_dirty = true;
+static inline void setpixel(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
+    // Skip messing with the dirty info if the original value already matches
+    if (surface->buffer[y * surface->base.panel_width + x] != rgb565) {
+        // Maintain dirty regions
+        mark_dirty(surface, x, y);
 
         // Update the pixel data in the buffer
         surface->buffer[y * surface->base.panel_width + x] = rgb565;
@@ -115,9 +190,8 @@ static bool qp_rgb565_surface_clear(painter_device_t device) {
 static bool qp_rgb565_surface_flush(painter_device_t device) {
     painter_driver_t *               driver  = (painter_driver_t *)device;
     rgb565_surface_painter_device_t *surface = (rgb565_surface_painter_device_t *)driver;
-    surface->dirty_l = surface->dirty_t = UINT16_MAX;
-    surface->dirty_r = surface->dirty_b = 0;
-    surface->is_dirty                   = false;
+    surface->dirty_count = 0;
+    surface->dirty_last  = 0;
     return true;
 }
 
@@ -233,17 +307,9 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Drawing routine to copy out the dirty region and send it to another device
 
-bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
-    painter_driver_t *               surface_driver = (painter_driver_t *)surface;
-    rgb565_surface_painter_device_t *surface_handle = (rgb565_surface_painter_device_t *)surface_driver;
-
-    // If we're not dirty... we're done.
-    if (!surface_handle->is_dirty) {
-        return true;
-    }
-
+static bool qp_rgb565_surface_draw_rect(rgb565_surface_painter_device_t *surface_handle, painter_device_t display, uint16_t x, uint16_t y, const rgb565_surface_dirty_rect_t *rect) {
     // Set the target drawing area
-    bool ok = qp_viewport(display, x + surface_handle->dirty_l, y + surface_handle->dirty_t, x + surface_handle->dirty_r, y + surface_handle->dirty_b);
+    bool ok = qp_viewport(display, x + rect->l, y + rect->t, x + rect->r, y + rect->b);
     if (!ok) {
         return false;
     }
@@ -254,8 +320,8 @@ bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display,
     uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
 
     // Fill the global pixdata area so that we can start transferring to the panel
-    for (uint16_t y = surface_handle->dirty_t; y <= surface_handle->dirty_b; ++y) {
-        for (uint16_t x = surface_handle->dirty_l; x <= surface_handle->dirty_r; ++x) {
+    for (uint16_t y = rect->t; y <= rect->b; ++y) {
+        for (uint16_t x = rect->l; x <= rect->r; ++x) {
             // Update the target buffer
             target_buffer[pixel_counter++] = surface_handle->buffer[y * surface_handle->base.panel_width + x];
 
@@ -279,6 +345,20 @@ bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display,
         }
     }
 
+    return true;
+}
+
+bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
+    painter_driver_t *               surface_driver = (painter_driver_t *)surface;
+    rgb565_surface_painter_device_t *surface_handle = (rgb565_surface_painter_device_t *)surface_driver;
+
+    // Transfer each of the dirty regions -- if we're not dirty, there's nothing to do
+    for (uint8_t i = 0; i < surface_handle->dirty_count; ++i) {
+        if (!qp_rgb565_surface_draw_rect(surface_handle, display, x, y, &surface_handle->dirty[i])) {
+            return false;
+        }
+    }
+
     // Clear the dirty info for the surface
     return qp_flush(surface);
 }
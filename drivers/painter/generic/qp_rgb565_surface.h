@@ -13,6 +13,15 @@
 #    define RGB565_SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef RGB565_SURFACE_NUM_DIRTY_RECTS
+/**
+ * @def This controls the maximum number of separate dirty regions tracked by each surface. Drawing to areas of the
+ *      surface that are far apart results in separate regions, so that only the modified areas are transferred to the
+ *      display. Once the limit is reached, regions are merged with their closest neighbour.
+ */
+#    define RGB565_SURFACE_NUM_DIRTY_RECTS 4
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -28,9 +37,10 @@
 painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
 
 /**
- * Helper method to draw the dirty contents of the framebuffer to the target device.
+ * Helper method to draw the dirty contents of the framebuffer to the target device. Each dirty region is transferred
+ * separately, so unmodified areas of the surface are skipped.
  *
- * After successful completion, the dirty area is reset.
+ * After successful completion, the dirty regions are reset.
  *
  * @param surface[in] the surface to copy from
  * @param display[in] the display to copy into
@@ -78,10 +78,10 @@ bool qp_tft_panel_viewport(painter_device_t device, uint16_t left, uint16_t top,
     return true;
 }
 
-// Stream pixel data to the current write position in GRAM
+// Stream pixel data to the current write position in GRAM -- the transfer may still be in progress on return
 bool qp_tft_panel_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
     painter_driver_t *driver = (painter_driver_t *)device;
-    qp_comms_send(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8);
+    qp_comms_send_async(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8);
     return true;
 }
 
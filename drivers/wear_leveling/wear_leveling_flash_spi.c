@@ -41,6 +41,24 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t *next_address) {
+    _Static_assert(((WEAR_LEVELING_BACKING_SIZE) / 2) % (EXTERNAL_FLASH_SECTOR_SIZE) == 0, "Each half of the backing size must be a multiple of EXTERNAL_FLASH_SECTOR_SIZE");
+
+    uint32_t sector_start = address - (address % (EXTERNAL_FLASH_SECTOR_SIZE));
+    bs_dprintf("Erase sector 0x%08lX\n", (unsigned long)sector_start);
+    *next_address = sector_start + (EXTERNAL_FLASH_SECTOR_SIZE);
+    // Completed in the background through backing_store_poll(), anything else touching the flash waits for it first
+    return flash_erase_sector_async((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + sector_start) == FLASH_STATUS_SUCCESS;
+}
+
+bool backing_store_poll(bool *busy) {
+    *busy = flash_task() == FLASH_STATUS_BUSY;
+    // The flash driver keeps any failure, as the erase may have been completed by another flash operation in the meantime
+    return flash_async_error() == FLASH_STATUS_SUCCESS;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
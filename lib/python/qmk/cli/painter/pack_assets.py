@@ -0,0 +1,116 @@
+"""Packs Quantum Painter images and fonts into a single image suitable for external flash.
+"""
+import re
+import struct
+import datetime
+from string import Template
+from qmk.path import normpath
+from qmk.painter import render_license
+from milc import cli
+
+# See quantum/painter/qp_stream.c
+ASSET_PACK_MAGIC = b'QPAK'
+ASSET_PACK_VERSION = 0x01
+ASSET_PACK_HEADER_SIZE = 8
+ASSET_PACK_ENTRY_SIZE = 8
+
+# The magic numbers of each supported file type, following the 5-byte block header. The version byte and total file size follow.
+asset_magics = {
+    b'QGF': 'image',
+    b'QFF': 'font',
+}
+
+asset_header_template = """\
+${license}
+#pragma once
+
+// Asset pack `${pack_name}`, ${byte_count} bytes -- flash this to external SPI flash at QP_ASSET_PACK_${sane_pack_name}_ADDRESS.
+#define QP_ASSET_PACK_${sane_pack_name}_ADDRESS 0x${base_address}
+#define QP_ASSET_PACK_${sane_pack_name}_SIZE ${byte_count}
+
+${asset_defines}
+"""
+
+
+def _read_asset(path):
+    """Reads and sanity-checks a raw QGF/QFF file, returning its type and contents.
+    """
+    data = path.read_bytes()
+    if len(data) < 13 or data[5:8] not in asset_magics:
+        return None, None
+
+    total_size = struct.unpack_from('<I', data, 9)[0]
+    if total_size != len(data):
+        return None, None
+
+    return asset_magics[data[5:8]], data
+
+
+@cli.argument('-o', '--output', required=True, help='Specify output asset pack path.')
+@cli.argument('-b', '--base-address', default='0', help='Address of the asset pack within external flash. Default 0.')
+@cli.argument('inputs', nargs='+', arg_only=True, help='Raw QGF/QFF files to pack, as generated with --raw.')
+@cli.subcommand('Packs QGF images and QFF fonts into an image suitable for external flash')
+def painter_pack_assets(cli):
+    """Packs raw QGF images and QFF fonts into a single flashable image, prefixed with an index of the contained assets.
+
+    A header file is written alongside the output, containing the address, offset, and index of each asset.
+    """
+    base_address = int(cli.args.base_address, 0)
+    output = normpath(cli.args.output)
+
+    # Read all the input assets
+    assets = []
+    for input in cli.args.inputs:
+        input = normpath(input)
+        if not input.exists():
+            cli.log.error(f'Input file {input} does not exist!')
+            return False
+
+        asset_type, data = _read_asset(input)
+        if data is None:
+            cli.log.error(f'Input file {input} is not a valid QGF or QFF file!')
+            return False
+
+        assets.append({'name': re.sub(r"[^a-zA-Z0-9]", "_", input.stem).upper(), 'type': asset_type, 'data': data})
+
+    if len(assets) > 0xFFFF:
+        cli.log.error('Too many assets supplied, an asset pack can contain at most 65535 assets!')
+        return False
+
+    # Lay out the index followed by each asset
+    offset = ASSET_PACK_HEADER_SIZE + len(assets) * ASSET_PACK_ENTRY_SIZE
+    pack = bytearray(ASSET_PACK_MAGIC + struct.pack('<HH', ASSET_PACK_VERSION, len(assets)))
+    for asset in assets:
+        asset['offset'] = offset
+        pack += struct.pack('<II', offset, len(asset['data']))
+        offset += len(asset['data'])
+
+    for asset in assets:
+        pack += asset['data']
+
+    print(f"Writing {output}...")
+    output.write_bytes(pack)
+
+    # Render the header so the keymap knows where each asset lives
+    asset_defines = []
+    for index, asset in enumerate(assets):
+        asset_defines.append(f"// {asset['type']}, {len(asset['data'])} bytes")
+        asset_defines.append(f"#define QP_ASSET_{asset['name']}_INDEX {index}")
+        asset_defines.append(f"#define QP_ASSET_{asset['name']}_ADDRESS 0x{base_address + asset['offset']:08X}")
+
+    subs = {
+        'generated_type': 'asset pack',
+        'generator_command': f'qmk painter-pack-assets -o {output.name} {" ".join(normpath(i).name for i in cli.args.inputs)}',
+        'year': datetime.date.today().strftime("%Y"),
+        'pack_name': output.name,
+        'sane_pack_name': re.sub(r"[^a-zA-Z0-9]", "_", output.stem).upper(),
+        'base_address': f'{base_address:08X}',
+        'byte_count': len(pack),
+        'asset_defines': '\n'.join(asset_defines),
+    }
+    subs.update({'license': render_license(subs)})
+
+    header_file = output.parent / (output.stem + ".h")
+    with open(header_file, 'w') as header:
+        print(f"Writing {header_file}...")
+        header.write(Template(asset_header_template).substitute(subs))
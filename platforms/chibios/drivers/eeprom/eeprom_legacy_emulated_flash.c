@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include "util.h"
 #include "debug.h"
+#include "eeprom_backend.h"
 #include "eeprom_legacy_emulated_flash.h"
 #include "legacy_flash_ops.h"
 
@@ -26,6 +26,67 @@ static SPIConfig spiConfig = {NULL, 0, 0, 0};
 static SPIConfig spiConfig = {false, NULL, 0, 0, 0, 0};
 #endif
 
+// State of the in-flight asynchronous transfer, modified only while the system is locked or from the SPI interrupt
+static const uint8_t *volatile asyncData           = NULL;
+static volatile uint32_t       asyncRemaining      = 0;
+static spi_async_callback_t    asyncCallback       = NULL;
+static void *                  asyncCallbackArg    = NULL;
+static volatile bool           asyncTransferActive = false;
+static volatile bool           asyncReleasePending = false;
+
+// Set by spi_stop_async() -- the peripheral is left running until the next spi_start() or spi_stop()
+static bool spiStopDeferred = false;
+
+static inline void spi_async_wait(void) {
+    while (asyncTransferActive) {
+    }
+}
+
+static void spi_async_end_cb(SPIDriver *spip) {
+    if (!asyncTransferActive) {
+        return;
+    }
+
+    // Chain the next block of a large transfer. Every LLD completes through the HAL's common _spi_isr_code(), which
+    // marks the driver SPI_COMPLETE, calls end_cb from the interrupt, and only returns it to SPI_READY if end_cb left
+    // the state alone -- restarting from end_cb is the supported pattern. spiStartSendI() is I-class, so it is called
+    // with the system locked from ISR context, and moves the driver back to SPI_ACTIVE.
+    if (asyncRemaining > 0) {
+        uint32_t       length = asyncRemaining < SPI_ASYNC_MAX_TRANSFER ? asyncRemaining : SPI_ASYNC_MAX_TRANSFER;
+        const uint8_t *data   = asyncData;
+        asyncData += length;
+        asyncRemaining -= length;
+        osalSysLockFromISR();
+        spiStartSendI(spip, length, data);
+        osalSysUnlockFromISR();
+        return;
+    }
+
+    // Release chip select straight away if spi_stop_async() was called while this transfer was in flight
+    if (asyncReleasePending) {
+        asyncReleasePending = false;
+        osalSysLockFromISR();
+        spiUnselectI(spip);
+        osalSysUnlockFromISR();
+    }
+
+    asyncTransferActive           = false;
+    spi_async_callback_t callback = asyncCallback;
+    asyncCallback                 = NULL;
+    if (callback) {
+        callback(asyncCallbackArg);
+    }
+}
+
+// Completes a release started by spi_stop_async(), waiting for its transfer to finish if need be
+static void spi_finish_deferred_stop(void) {
+    if (spiStopDeferred) {
+        spi_async_wait();
+        spiStop(&SPI_DRIVER);
+        spiStopDeferred = false;
+    }
+}
+
 __attribute__((weak)) void spi_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -56,6 +117,8 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
         return false;
     }
 
+    spi_finish_deferred_stop();
+
 #if !(defined(WB32F3G71xx) || defined(WB32FQ95xx))
     uint16_t roundedDivisor = 2;
     while (roundedDivisor < divisor) {
@@ -250,6 +313,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     currentSlavePin  = slavePin;
     spiConfig.ssport = PAL_PORT(slavePin);
     spiConfig.sspad  = PAL_PAD(slavePin);
+    spiConfig.end_cb = spi_async_end_cb;
 
     setPinOutput(slavePin);
     spiStart(&SPI_DRIVER, &spiConfig);
@@ -259,6 +323,8 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 }
 
 spi_status_t spi_write(uint8_t data) {
+    spi_async_wait();
+
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -266,6 +332,8 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_async_wait();
+
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -273,17 +341,74 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_async_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_async_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint32_t length) {
+    if (currentSlavePin == NO_PIN) {
+        return SPI_STATUS_ERROR;
+    }
+
+    spi_async_wait();
+    if (length == 0) {
+        return SPI_STATUS_SUCCESS;
+    }
+
+    uint32_t first = length < SPI_ASYNC_MAX_TRANSFER ? length : SPI_ASYNC_MAX_TRANSFER;
+    osalSysLock();
+    asyncData           = data + first;
+    asyncRemaining      = length - first;
+    asyncCallback       = NULL;
+    asyncTransferActive = true;
+    spiStartSendI(&SPI_DRIVER, first, data);
+    osalSysUnlock();
+    return SPI_STATUS_SUCCESS;
+}
+
+bool spi_async_busy(void) {
+    return asyncTransferActive;
+}
+
+void spi_async_notify(spi_async_callback_t callback, void *cb_arg) {
+    osalSysLock();
+    bool busy = asyncTransferActive;
+    if (busy) {
+        asyncCallback    = callback;
+        asyncCallbackArg = cb_arg;
+    }
+    osalSysUnlock();
+
+    if (!busy && callback) {
+        callback(cb_arg);
+    }
+}
+
+void spi_stop_async(void) {
+    if (currentSlavePin != NO_PIN) {
+        osalSysLock();
+        if (asyncTransferActive) {
+            asyncReleasePending = true;
+        } else {
+            spiUnselectI(&SPI_DRIVER);
+        }
+        osalSysUnlock();
+        spiStopDeferred = true;
+        currentSlavePin = NO_PIN;
+    }
+}
+
 void spi_stop(void) {
+    spi_finish_deferred_stop();
     if (currentSlavePin != NO_PIN) {
+        spi_async_wait();
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
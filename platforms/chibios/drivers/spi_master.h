@@ -72,6 +72,13 @@ typedef int16_t spi_status_t;
 #define SPI_TIMEOUT_IMMEDIATE (0)
 #define SPI_TIMEOUT_INFINITE (0xFFFF)
 
+// Maximum number of bytes handed to the SPI peripheral's DMA in a single transaction
+#ifndef SPI_ASYNC_MAX_TRANSFER
+#    define SPI_ASYNC_MAX_TRANSFER 65535
+#endif
+
+typedef void (*spi_async_callback_t)(void *cb_arg);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -87,6 +94,30 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+/**
+ * Starts transmitting the supplied data in the background, returning immediately. The data must remain valid until
+ * the transfer is complete, which can be checked with spi_async_busy(). Transfers larger than SPI_ASYNC_MAX_TRANSFER
+ * are split and chained from the completion interrupt. Any previous asynchronous transfer is waited upon first.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint32_t length);
+
+/**
+ * Returns true while an asynchronous transfer started with spi_transmit_async() is still in progress.
+ */
+bool spi_async_busy(void);
+
+/**
+ * Invokes the callback once the in-flight asynchronous transfer completes -- from interrupt context, so it must be
+ * short and only use ISR-safe APIs. If no transfer is in flight, the callback is invoked immediately.
+ */
+void spi_async_notify(spi_async_callback_t callback, void *cb_arg);
+
+/**
+ * Releases the bus without waiting for an in-flight asynchronous transfer. Chip select is deasserted from the
+ * completion interrupt once the transfer finishes, and spi_start() waits for that before handing the bus to anyone else.
+ */
+void spi_stop_async(void);
+
 void spi_stop(void);
 #ifdef __cplusplus
 }
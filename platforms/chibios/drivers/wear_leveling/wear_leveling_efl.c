@@ -117,6 +117,37 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t *next_address) {
+    for (int i = 0; i < sector_count; ++i) {
+        uint32_t sector_start = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        uint32_t sector_end   = sector_start + flashGetSectorSize(flash, first_sector + i);
+        if (address >= sector_start && address < sector_end) {
+            // Sector sizes vary, so a sector may straddle the two halves of the backing store -- never erase one of those
+            const uint32_t half = (WEAR_LEVELING_BACKING_SIZE) / 2;
+            if (sector_start < half && sector_end > half) {
+                bs_dprintf("Sector %d straddles both banks, refusing to erase\n", (int)(first_sector + i));
+                return false;
+            }
+
+            bs_dprintf("Erase sector %d\n", (int)(first_sector + i));
+            *next_address = sector_end;
+
+            // Kick off the sector erase
+            flash_error_t status = flashStartEraseSector(flash, first_sector + i);
+            if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+                return false;
+            }
+
+            // Wait for the erase to complete
+            status = flashWaitErase(flash);
+            return status == FLASH_NO_ERROR || status == FLASH_BUSY_ERASING;
+        }
+    }
+    return false;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -139,3 +170,14 @@ bool backing_store_read(uint32_t address, backing_store_int_t *value) {
     wl_dump(offset, value, sizeof(backing_store_int_t));
     return true;
 }
+
+bool backing_store_read_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
+    uint32_t             offset = (base_offset + address);
+    backing_store_int_t *loc    = (backing_store_int_t *)flashGetOffsetAddress(flash, offset);
+    for (size_t i = 0; i < item_count; ++i) {
+        values[i] = ~loc[i];
+    }
+    bs_dprintf("Read  ");
+    wl_dump(offset, values, sizeof(backing_store_int_t) * item_count);
+    return true;
+}
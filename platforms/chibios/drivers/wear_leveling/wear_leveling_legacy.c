@@ -36,6 +36,17 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t *next_address) {
+    _Static_assert(((WEAR_LEVELING_BACKING_SIZE) / 2) % (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE) == 0, "Each half of the backing size must be a multiple of WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE");
+
+    uint32_t page_start = address - (address % (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE));
+    bs_dprintf("Erase page 0x%08lX\n", (unsigned long)page_start);
+    *next_address = page_start + (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE);
+    return FLASH_ErasePage((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + page_start) == FLASH_COMPLETE;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
     bs_dprintf("Write ");
@@ -57,3 +68,14 @@ bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     wl_dump(offset, loc, sizeof(backing_store_int_t));
     return true;
 }
+
+bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    uint32_t             offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
+    backing_store_int_t* loc    = (backing_store_int_t*)offset;
+    for (size_t i = 0; i < item_count; ++i) {
+        values[i] = ~loc[i];
+    }
+    bs_dprintf("Read  ");
+    wl_dump(offset, loc, sizeof(backing_store_int_t) * item_count);
+    return true;
+}
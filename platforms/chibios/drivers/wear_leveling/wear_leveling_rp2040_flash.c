@@ -187,6 +187,21 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t *next_address) {
+    _Static_assert(((WEAR_LEVELING_BACKING_SIZE) / 2) % (FLASH_SECTOR_SIZE) == 0, "Each half of the backing size must be a multiple of FLASH_SECTOR_SIZE");
+
+    uint32_t sector_start = address - (address % (FLASH_SECTOR_SIZE));
+    bs_dprintf("Erase sector 0x%08lX\n", (unsigned long)sector_start);
+    *next_address = sector_start + (FLASH_SECTOR_SIZE);
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + sector_start, (FLASH_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    return true;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
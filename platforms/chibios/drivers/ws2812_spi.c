@@ -1,5 +1,6 @@
 #include "quantum.h"
 #include "ws2812.h"
+#include <string.h>
 
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
 
@@ -84,54 +85,57 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+#if defined(WS2812_SPI_DOUBLE_BUFFER) && defined(WS2812_SPI_USE_CIRCULAR_BUFFER)
+#    error "WS2812_SPI_DOUBLE_BUFFER cannot be used together with WS2812_SPI_USE_CIRCULAR_BUFFER"
+#endif
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+#    define TXBUF_COUNT 2
+#else
+#    define TXBUF_COUNT 1
+#endif
+
+static uint8_t  txbufs[TXBUF_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {{0}};
+static uint8_t* txbuf                                                       = txbufs[0];
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, every pair of data bits is translated into one SPI
+ * byte with the appropriate timing. The table below holds the 4 SPI bytes for
+ * each possible data byte, so encoding is a single lookup per colour channel.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#define WS2812_SPI_BITS(x) ((((x)&2) ? 0b11100000 : 0b10000000) | (((x)&1) ? 0b1110 : 0b1000))
+#define WS2812_SPI_ENCODE(d) \
+    { WS2812_SPI_BITS((d) >> 6), WS2812_SPI_BITS((d) >> 4), WS2812_SPI_BITS((d) >> 2), WS2812_SPI_BITS(d) }
+#define WS2812_SPI_ENCODE_4(d) WS2812_SPI_ENCODE(d), WS2812_SPI_ENCODE((d) + 1), WS2812_SPI_ENCODE((d) + 2), WS2812_SPI_ENCODE((d) + 3)
+#define WS2812_SPI_ENCODE_16(d) WS2812_SPI_ENCODE_4(d), WS2812_SPI_ENCODE_4((d) + 4), WS2812_SPI_ENCODE_4((d) + 8), WS2812_SPI_ENCODE_4((d) + 12)
+#define WS2812_SPI_ENCODE_64(d) WS2812_SPI_ENCODE_16(d), WS2812_SPI_ENCODE_16((d) + 16), WS2812_SPI_ENCODE_16((d) + 32), WS2812_SPI_ENCODE_16((d) + 48)
+
+static const uint8_t protocol_eq[256][BYTES_FOR_LED_BYTE] = {WS2812_SPI_ENCODE_64(0), WS2812_SPI_ENCODE_64(64), WS2812_SPI_ENCODE_64(128), WS2812_SPI_ENCODE_64(192)};
+
+static inline uint8_t* set_led_byte(uint8_t* tx, uint8_t data) {
+    memcpy(tx, protocol_eq[data], BYTES_FOR_LED_BYTE);
+    return tx + BYTES_FOR_LED_BYTE;
 }
 
 static void set_led_color_rgb(LED_TYPE color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+    uint8_t* tx = &txbuf[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    tx = set_led_byte(tx, color.g);
+    tx = set_led_byte(tx, color.r);
+    tx = set_led_byte(tx, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    tx = set_led_byte(tx, color.r);
+    tx = set_led_byte(tx, color.g);
+    tx = set_led_byte(tx, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    tx = set_led_byte(tx, color.b);
+    tx = set_led_byte(tx, color.g);
+    tx = set_led_byte(tx, color.r);
 #endif
 #ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+    set_led_byte(tx, color.w);
 #endif
 }
 
@@ -181,7 +185,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbufs[0]), txbuf);
 #endif
 }
 
@@ -192,7 +196,12 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         s_init = true;
     }
 
-    for (uint8_t i = 0; i < leds; i++) {
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    // encode into the idle buffer while the previous frame may still be in flight
+    txbuf = (txbuf == txbufs[0]) ? txbufs[1] : txbufs[0];
+#endif
+
+    for (uint16_t i = 0; i < leds; i++) {
         set_led_color_rgb(ledarray[i], i);
     }
 
@@ -200,9 +209,15 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI, ARRAY_SIZE(txbufs[0]), txbuf);
 #    else
-    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbuf), txbuf);
+#        ifdef WS2812_SPI_DOUBLE_BUFFER
+    // only the hand-over has to wait for the previous transfer to complete,
+    // the state is changed from the SPI ISR so must be re-read on every pass
+    while (*(volatile spistate_t*)&WS2812_SPI.state == SPI_ACTIVE) {
+    }
+#        endif
+    spiStartSend(&WS2812_SPI, ARRAY_SIZE(txbufs[0]), txbuf);
 #    endif
 #endif
 }
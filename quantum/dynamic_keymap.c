@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "keymap_introspection.h" // to get keymaps[][][]
 #include "eeprom.h"
 #include "progmem.h" // to read default from flash
@@ -98,6 +100,62 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+// Macro bytes are read from EEPROM this many at a time when indexing or sending
+#define DYNAMIC_KEYMAP_MACRO_READ_CHUNK_SIZE 16
+
+// Offset of each macro within the buffer, so that sending one does not have to
+// scan past all of those before it. Macros missing from the buffer are recorded
+// as DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE.
+static uint16_t dynamic_keymap_macro_index[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     dynamic_keymap_macro_index_valid = false;
+// Whether the buffer was terminated when indexed, i.e. not partway through being written
+static bool dynamic_keymap_macro_buffer_valid = false;
+
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+// RAM budget for the keymap cache; boards with more to spare can raise it
+#    ifndef DYNAMIC_KEYMAP_CACHE_MAX_SIZE
+#        ifdef __AVR__
+#            define DYNAMIC_KEYMAP_CACHE_MAX_SIZE 512
+#        else
+#            define DYNAMIC_KEYMAP_CACHE_MAX_SIZE 8192
+#        endif
+#    endif
+
+// Keycodes are kept in native byte order, whereas the EEPROM copy is big endian
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+#    ifdef ENCODER_MAP_ENABLE
+static uint16_t dynamic_keymap_encoder_cache[DYNAMIC_KEYMAP_LAYER_COUNT][NUM_ENCODERS][2];
+#        define DYNAMIC_KEYMAP_CACHE_SIZE (sizeof(dynamic_keymap_cache) + sizeof(dynamic_keymap_encoder_cache))
+#    else
+#        define DYNAMIC_KEYMAP_CACHE_SIZE (sizeof(dynamic_keymap_cache))
+#    endif
+static bool dynamic_keymap_cache_valid = false;
+
+_Static_assert(DYNAMIC_KEYMAP_CACHE_SIZE <= DYNAMIC_KEYMAP_CACHE_MAX_SIZE, "Dynamic keymap cache needs more RAM than DYNAMIC_KEYMAP_CACHE_MAX_SIZE allows. Reduce DYNAMIC_KEYMAP_LAYER_COUNT, or increase DYNAMIC_KEYMAP_CACHE_MAX_SIZE if the MCU has RAM to spare.");
+
+// Converts a buffer read straight from EEPROM into native keycodes, in place
+static void dynamic_keymap_cache_from_eeprom(uint16_t *keycodes, uint16_t count) {
+    uint8_t *bytes = (uint8_t *)keycodes;
+    for (uint16_t i = 0; i < count; i++) {
+        keycodes[i] = (bytes[i * 2] << 8) | bytes[i * 2 + 1];
+    }
+}
+
+static void dynamic_keymap_cache_load(void) {
+    eeprom_read_block(dynamic_keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_cache));
+    dynamic_keymap_cache_from_eeprom(&dynamic_keymap_cache[0][0][0], sizeof(dynamic_keymap_cache) / sizeof(uint16_t));
+#    ifdef ENCODER_MAP_ENABLE
+    eeprom_read_block(dynamic_keymap_encoder_cache, (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, sizeof(dynamic_keymap_encoder_cache));
+    dynamic_keymap_cache_from_eeprom(&dynamic_keymap_encoder_cache[0][0][0], sizeof(dynamic_keymap_encoder_cache) / sizeof(uint16_t));
+#    endif // ENCODER_MAP_ENABLE
+    dynamic_keymap_cache_valid = true;
+}
+
+void dynamic_keymap_cache_invalidate(void) {
+    dynamic_keymap_cache_valid = false;
+}
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -109,11 +167,18 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    if (!dynamic_keymap_cache_valid) {
+        dynamic_keymap_cache_load();
+    }
+    return dynamic_keymap_cache[layer][row][column];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
@@ -122,6 +187,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    dynamic_keymap_cache[layer][row][column] = keycode;
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -131,11 +199,18 @@ void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+#    ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    if (!dynamic_keymap_cache_valid) {
+        dynamic_keymap_cache_load();
+    }
+    return dynamic_keymap_encoder_cache[layer][encoder_id][clockwise ? 0 : 1];
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
     keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
+#    endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
@@ -144,6 +219,9 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+#    ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    dynamic_keymap_encoder_cache[layer][encoder_id][clockwise ? 0 : 1] = keycode;
+#    endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -175,30 +253,28 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    // Anything past the end of the keymaps reads as zero
+    uint16_t valid = offset < dynamic_keymap_eeprom_size ? MIN(size, dynamic_keymap_eeprom_size - offset) : 0;
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), valid);
+    memset(data + valid, 0, size - valid);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+    if (offset >= dynamic_keymap_eeprom_size) return;
+    size = MIN(size, dynamic_keymap_eeprom_size - offset);
+    eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), size);
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    // Patch the matching halves of the cached keycodes
+    for (uint16_t i = offset; i < offset + size; i++) {
+        uint16_t *cached = &dynamic_keymap_cache[0][0][0] + i / 2;
+        if (i & 1) {
+            *cached = (*cached & 0xFF00) | data[i - offset];
+        } else {
+            *cached = (*cached & 0x00FF) | (data[i - offset] << 8);
         }
-        source++;
-        target++;
     }
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -225,30 +301,47 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
     return DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
 }
 
-void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
+static void dynamic_keymap_macro_index_build(void) {
+    uint8_t  chunk[DYNAMIC_KEYMAP_MACRO_READ_CHUNK_SIZE];
+    uint16_t offset = 0;
+    uint16_t start  = 0;
+    uint8_t  id     = 0;
+
+    // Each macro is only recorded once its null terminator is found, with the next one starting straight after
+    while (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        uint16_t len = MIN(sizeof(chunk), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset);
+        eeprom_read_block(chunk, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), len);
+        for (uint16_t i = 0; i < len && id < DYNAMIC_KEYMAP_MACRO_COUNT; ++i) {
+            if (chunk[i] == 0) {
+                dynamic_keymap_macro_index[id++] = start;
+                start                            = offset + i + 1;
+            }
         }
-        source++;
-        target++;
+        offset += len;
+    }
+    while (id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        dynamic_keymap_macro_index[id++] = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
     }
+
+    dynamic_keymap_macro_buffer_valid = eeprom_read_byte((void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1)) == 0;
+    dynamic_keymap_macro_index_valid  = true;
+}
+
+void dynamic_keymap_macro_index_invalidate(void) {
+    dynamic_keymap_macro_index_valid = false;
+}
+
+void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    // Anything past the end of the macro buffer reads as zero
+    uint16_t valid = offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) : 0;
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid);
+    memset(data + valid, 0, size - valid);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    if (offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) return;
+    eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset));
+    dynamic_keymap_macro_index_invalidate();
 }
 
 void dynamic_keymap_macro_reset(void) {
@@ -258,6 +351,29 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+    dynamic_keymap_macro_index_invalidate();
+}
+
+// Reads a macro sequentially, a chunk of EEPROM at a time
+typedef struct {
+    uint16_t offset;
+    uint8_t  pos;
+    uint8_t  len;
+    uint8_t  data[DYNAMIC_KEYMAP_MACRO_READ_CHUNK_SIZE];
+} dynamic_keymap_macro_reader_t;
+
+static uint8_t dynamic_keymap_macro_read_next(dynamic_keymap_macro_reader_t *reader) {
+    if (reader->pos == reader->len) {
+        // Past the end of the buffer reads as the null terminator
+        if (reader->offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+            return 0;
+        }
+        reader->len = MIN(sizeof(reader->data), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - reader->offset);
+        reader->pos = 0;
+        eeprom_read_block(reader->data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + reader->offset), reader->len);
+        reader->offset += reader->len;
+    }
+    return reader->data[reader->pos++];
 }
 
 void dynamic_keymap_macro_send(uint8_t id) {
@@ -265,37 +381,30 @@ void dynamic_keymap_macro_send(uint8_t id) {
         return;
     }
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    if (!dynamic_keymap_macro_index_valid) {
+        dynamic_keymap_macro_index_build();
+    }
+
+    // If the last byte of the buffer is not zero, then we are
+    // in the middle of buffer writing, possibly an aborted
+    // buffer write. So do nothing.
+    if (!dynamic_keymap_macro_buffer_valid) {
         return;
     }
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then there is
-        // no Nth macro in the buffer.
-        if (p == end) {
-            return;
-        }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
-        }
-        ++p;
+    // If the Nth macro starts at the end of the buffer,
+    // then there is no Nth macro in the buffer.
+    if (dynamic_keymap_macro_index[id] >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        return;
     }
+    dynamic_keymap_macro_reader_t reader = {.offset = dynamic_keymap_macro_index[id]};
 
     // Send the macro string by making a temporary string.
     char data[8] = {0};
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_macro_read_next(&reader);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -303,14 +412,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_macro_read_next(&reader);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_macro_read_next(&reader);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -322,7 +431,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_macro_read_next(&reader);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
@@ -27,6 +27,11 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+// Discards the RAM copy of the keymap, so it is reloaded from EEPROM on the next lookup.
+// Only needed if the EEPROM is modified without going through the functions above.
+void dynamic_keymap_cache_invalidate(void);
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -68,3 +73,7 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+// Discards the index of macro offsets, so the buffer is rescanned on the next send.
+// Only needed if the EEPROM is modified without going through the functions above.
+void dynamic_keymap_macro_index_invalidate(void);
@@ -13,12 +13,193 @@
 #    include "haptic.h"
 #endif
 
+#if defined(DYNAMIC_KEYMAP_ENABLE)
+#    include "dynamic_keymap.h"
+#endif
+
+#if defined(EECONFIG_CACHE_ENABLE)
+#    include "fnv.h"
+#endif
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#if defined(EECONFIG_CACHE_ENABLE)
+#    define EECONFIG_STORED_MAGIC_NUMBER EECONFIG_CACHE_MAGIC_NUMBER
+#else
+#    define EECONFIG_STORED_MAGIC_NUMBER EECONFIG_MAGIC_NUMBER
+#endif
+
+#if defined(EECONFIG_CACHE_ENABLE)
+#    if !defined(TOTAL_EEPROM_BYTE_COUNT)
+#        error EECONFIG_CACHE_ENABLE requires TOTAL_EEPROM_BYTE_COUNT, so that data saved without the cache can be migrated
+#    endif
+_Static_assert(EECONFIG_CACHE_MAGIC_NUMBER != EECONFIG_MAGIC_NUMBER_OFF, "EECONFIG_MAGIC_NUMBER must not be 0");
+
+/*
+    The eeconfig region is read into RAM with a single block read on first
+    access, and served from there afterwards. Updates are written through to
+    EEPROM together with an FNV-1a checksum of the region, so that corruption
+    is detected the next time it is loaded. Only the eeconfig region is reset
+    to defaults when that happens, anything else in EEPROM is left alone.
+
+    Alongside the checksum is the layout version, and data saved with an older
+    layout is migrated forward when it is loaded. The only older layout so far
+    is the one used without the cache, which has no version or checksum, and is
+    recognised by its magic number -- EECONFIG_CACHE_MAGIC_NUMBER is stored in
+    its place once cached. Data saved with a layout version this firmware
+    doesn't know about is reset.
+*/
+static uint8_t eeconfig_cache[(EECONFIG_SIZE)];
+static bool    eeconfig_cache_loaded = false;
+
+static void eeconfig_init_settings(void);
+
+static uint32_t eeconfig_cache_checksum(void) {
+    Fnv32_t hash = fnv_32a_buf(eeconfig_cache, (uintptr_t)EECONFIG_CHECKSUM, FNV1_32A_INIT);
+    return fnv_32a_buf(&eeconfig_cache[(EECONFIG_BASE_SIZE)], (EECONFIG_SIZE) - (EECONFIG_BASE_SIZE), hash);
+}
+
+static bool eeconfig_cache_is_valid(void) {
+    uint32_t checksum;
+    memcpy(&checksum, &eeconfig_cache[(uintptr_t)EECONFIG_CHECKSUM], sizeof(checksum));
+    return checksum == eeconfig_cache_checksum();
+}
+
+static void eeconfig_cache_store_checksum(void) {
+    uint32_t checksum = eeconfig_cache_checksum();
+    memcpy(&eeconfig_cache[(uintptr_t)EECONFIG_CHECKSUM], &checksum, sizeof(checksum));
+}
+
+/*
+ * Moves everything stored after the end of the eeconfig region up by the given number of bytes. VIA, the dynamic keymap
+ * and anything else placed after the region address it relative to EECONFIG_SIZE, so they move along with its end.
+ */
+static void eeconfig_cache_move_trailing_data(uint32_t old_size, uint32_t shift) {
+    uint8_t  buffer[32];
+    uint32_t end = (TOTAL_EEPROM_BYTE_COUNT) - shift;
+    while (end > old_size) {
+        uint32_t len = (end - old_size < sizeof(buffer)) ? end - old_size : sizeof(buffer);
+        end -= len;
+        eeprom_read_block(buffer, (const void *)(uintptr_t)end, len);
+        eeprom_update_block(buffer, (void *)(uintptr_t)(end + shift), len);
+    }
+#if defined(DYNAMIC_KEYMAP_ENABLE)
+#    if defined(DYNAMIC_KEYMAP_CACHE_ENABLE)
+    dynamic_keymap_cache_invalidate();
+#    endif
+    dynamic_keymap_macro_index_invalidate();
+#endif
+}
+
+/*
+ * Saved without the cache -- the version and checksum now sit where the keyboard and user datablocks started, so those
+ * and everything after them are moved up.
+ */
+static void eeconfig_cache_migrate_uncached(void) {
+    const uint32_t shift = (EECONFIG_BASE_SIZE) - (uintptr_t)EECONFIG_VERSION;
+    eeconfig_cache_move_trailing_data((EECONFIG_SIZE) - shift, shift);
+    memmove(&eeconfig_cache[(EECONFIG_BASE_SIZE)], &eeconfig_cache[(uintptr_t)EECONFIG_VERSION], (EECONFIG_SIZE) - (EECONFIG_BASE_SIZE));
+    const uint16_t magic = EECONFIG_CACHE_MAGIC_NUMBER;
+    memcpy(&eeconfig_cache[(uintptr_t)EECONFIG_MAGIC], &magic, sizeof(magic));
+    eeconfig_cache[(uintptr_t)EECONFIG_VERSION] = (EECONFIG_LAYOUT_VERSION);
+    eeconfig_cache_store_checksum();
+    eeprom_update_block(eeconfig_cache, (void *)0, (EECONFIG_SIZE));
+}
+
+static void eeconfig_cache_migrate(void) {
+    if (!eeconfig_cache_is_valid()) {
+        // Interrupted update, or written without going through the cache
+        eeconfig_init_settings();
+        eeconfig_init_kb();
+        return;
+    }
+
+    switch (eeconfig_cache[(uintptr_t)EECONFIG_VERSION]) {
+        case (EECONFIG_LAYOUT_VERSION):
+            return;
+        default:
+            // Saved with a layout this firmware doesn't know about
+            eeconfig_init_settings();
+            eeconfig_init_kb();
+            return;
+    }
+}
+
+static void eeconfig_cache_load(void) {
+    eeprom_read_block(eeconfig_cache, (const void *)0, (EECONFIG_SIZE));
+    eeconfig_cache_loaded = true;
+
+    uint16_t magic;
+    memcpy(&magic, &eeconfig_cache[(uintptr_t)EECONFIG_MAGIC], sizeof(magic));
+    if (magic == EECONFIG_CACHE_MAGIC_NUMBER) {
+        eeconfig_cache_migrate();
+    } else if (magic == EECONFIG_MAGIC_NUMBER) {
+        eeconfig_cache_migrate_uncached();
+    }
+}
+
+static inline bool eeconfig_cache_contains(const void *addr, size_t len) {
+    return (uintptr_t)addr + len <= (EECONFIG_SIZE);
+}
+
+void eeconfig_read_block(void *buf, const void *addr, size_t len) {
+    if (!eeconfig_cache_contains(addr, len)) {
+        eeprom_read_block(buf, addr, len);
+        return;
+    }
+    if (!eeconfig_cache_loaded) {
+        eeconfig_cache_load();
+    }
+    memcpy(buf, &eeconfig_cache[(uintptr_t)addr], len);
+}
+
+void eeconfig_update_block(const void *buf, void *addr, size_t len) {
+    if (!eeconfig_cache_contains(addr, len)) {
+        eeprom_update_block(buf, addr, len);
+        return;
+    }
+    if (!eeconfig_cache_loaded) {
+        eeconfig_cache_load();
+    }
+    if (memcmp(&eeconfig_cache[(uintptr_t)addr], buf, len) == 0) {
+        return;
+    }
+    memcpy(&eeconfig_cache[(uintptr_t)addr], buf, len);
+    eeconfig_cache_store_checksum();
+    eeprom_update_block(buf, addr, len);
+    eeprom_update_block(&eeconfig_cache[(uintptr_t)EECONFIG_CHECKSUM], EECONFIG_CHECKSUM, sizeof(uint32_t));
+}
+
+uint8_t eeconfig_read_byte(const uint8_t *addr) {
+    uint8_t value;
+    eeconfig_read_block(&value, addr, sizeof(value));
+    return value;
+}
+uint16_t eeconfig_read_word(const uint16_t *addr) {
+    uint16_t value;
+    eeconfig_read_block(&value, addr, sizeof(value));
+    return value;
+}
+uint32_t eeconfig_read_dword(const uint32_t *addr) {
+    uint32_t value;
+    eeconfig_read_block(&value, addr, sizeof(value));
+    return value;
+}
+void eeconfig_update_byte(uint8_t *addr, uint8_t value) {
+    eeconfig_update_block(&value, addr, sizeof(value));
+}
+void eeconfig_update_word(uint16_t *addr, uint16_t value) {
+    eeconfig_update_block(&value, addr, sizeof(value));
+}
+void eeconfig_update_dword(uint32_t *addr, uint32_t value) {
+    eeconfig_update_block(&value, addr, sizeof(value));
+}
+#endif // EECONFIG_CACHE_ENABLE
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -40,29 +221,28 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 }
 
 /*
- * FIXME: needs doc
+ * Resets the eeconfig region to defaults, including the keyboard and user datablocks, leaving the rest of EEPROM alone.
  */
-void eeconfig_init_quantum(void) {
-#if defined(EEPROM_DRIVER)
-    eeprom_driver_erase();
+static void eeconfig_init_settings(void) {
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_STORED_MAGIC_NUMBER);
+#if defined(EECONFIG_CACHE_ENABLE)
+    eeconfig_update_byte(EECONFIG_VERSION, EECONFIG_LAYOUT_VERSION);
 #endif
-
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
-    eeprom_update_byte(EECONFIG_DEBUG, 0);
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, 0);
+    eeconfig_update_byte(EECONFIG_DEBUG, 0);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, 0);
     default_layer_state = 0;
     // Enable oneshot and autocorrect by default: 0b0001 0100 0000 0000
-    eeprom_update_word(EECONFIG_KEYMAP, 0x1400);
-    eeprom_update_byte(EECONFIG_BACKLIGHT, 0);
-    eeprom_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
-    eeprom_update_dword(EECONFIG_RGBLIGHT, 0);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
-    eeprom_update_byte(EECONFIG_VELOCIKEY, 0);
-    eeprom_update_byte(EECONFIG_UNICODEMODE, 0);
-    eeprom_update_byte(EECONFIG_STENOMODE, 0);
+    eeconfig_update_word(EECONFIG_KEYMAP, 0x1400);
+    eeconfig_update_byte(EECONFIG_BACKLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
+    eeconfig_update_byte(EECONFIG_VELOCIKEY, 0);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, 0);
+    eeconfig_update_byte(EECONFIG_STENOMODE, 0);
     uint64_t dummy = 0;
-    eeprom_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
+    eeconfig_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
+    eeconfig_update_dword(EECONFIG_HAPTIC, 0);
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
@@ -74,6 +254,26 @@ void eeconfig_init_quantum(void) {
 #if (EECONFIG_USER_DATA_SIZE) > 0
     eeconfig_init_user_datablock();
 #endif
+}
+
+/*
+ * FIXME: needs doc
+ */
+void eeconfig_init_quantum(void) {
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_erase();
+#    if defined(EECONFIG_CACHE_ENABLE)
+    eeconfig_cache_loaded = false;
+#    endif
+#endif
+#if defined(DYNAMIC_KEYMAP_ENABLE)
+#    if defined(DYNAMIC_KEYMAP_CACHE_ENABLE)
+    dynamic_keymap_cache_invalidate();
+#    endif
+    dynamic_keymap_macro_index_invalidate();
+#endif
+
+    eeconfig_init_settings();
 
 #if defined(VIA_ENABLE)
     // Invalidate VIA eeprom config, and then reset.
@@ -99,7 +299,10 @@ void eeconfig_init(void) {
  * FIXME: needs doc
  */
 void eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_STORED_MAGIC_NUMBER);
+#if defined(EECONFIG_CACHE_ENABLE)
+    eeconfig_update_byte(EECONFIG_VERSION, EECONFIG_LAYOUT_VERSION);
+#endif
 }
 
 /** \brief eeconfig disable
@@ -109,8 +312,17 @@ void eeconfig_enable(void) {
 void eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+#    if defined(EECONFIG_CACHE_ENABLE)
+    eeconfig_cache_loaded = false;
+#    endif
+#endif
+#if defined(DYNAMIC_KEYMAP_ENABLE)
+#    if defined(DYNAMIC_KEYMAP_CACHE_ENABLE)
+    dynamic_keymap_cache_invalidate();
+#    endif
+    dynamic_keymap_macro_index_invalidate();
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
 }
 
 /** \brief eeconfig is enabled
@@ -118,7 +330,7 @@ void eeconfig_disable(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_enabled(void) {
-    bool is_eeprom_enabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
+    bool is_eeprom_enabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_STORED_MAGIC_NUMBER);
 #ifdef VIA_ENABLE
     if (is_eeprom_enabled) {
         is_eeprom_enabled = via_eeprom_is_valid();
@@ -132,7 +344,7 @@ bool eeconfig_is_enabled(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_disabled(void) {
-    bool is_eeprom_disabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
+    bool is_eeprom_disabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
 #ifdef VIA_ENABLE
     if (!is_eeprom_disabled) {
         is_eeprom_disabled = !via_eeprom_is_valid();
@@ -146,14 +358,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return eeconfig_read_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    eeconfig_update_byte(EECONFIG_DEBUG, val);
 }
 
 /** \brief eeconfig read default layer
@@ -161,14 +373,14 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_default_layer(void) {
-    return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    return eeconfig_read_byte(EECONFIG_DEFAULT_LAYER);
 }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
 void eeconfig_update_default_layer(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 /** \brief eeconfig read keymap
@@ -176,14 +388,14 @@ void eeconfig_update_default_layer(uint8_t val) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return eeprom_read_word(EECONFIG_KEYMAP);
+    return eeconfig_read_word(EECONFIG_KEYMAP);
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_word(EECONFIG_KEYMAP, val);
+    eeconfig_update_word(EECONFIG_KEYMAP, val);
 }
 
 /** \brief eeconfig read audio
@@ -191,14 +403,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return eeconfig_read_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    eeconfig_update_byte(EECONFIG_AUDIO, val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
@@ -207,14 +419,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
@@ -224,14 +436,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_read_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
@@ -240,14 +452,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return eeconfig_read_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    eeconfig_update_dword(EECONFIG_HAPTIC, val);
 }
 
 /** \brief eeconfig read split handedness
@@ -255,14 +467,14 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_read_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
@@ -271,7 +483,7 @@ void eeconfig_update_handedness(bool val) {
  * FIXME: needs doc
  */
 bool eeconfig_is_kb_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
 }
 /** \brief eeconfig read keyboard data block
  *
@@ -279,7 +491,7 @@ bool eeconfig_is_kb_datablock_valid(void) {
  */
 void eeconfig_read_kb_datablock(void *data) {
     if (eeconfig_is_kb_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+        eeconfig_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_KB_DATA_SIZE));
     }
@@ -289,8 +501,8 @@ void eeconfig_read_kb_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_kb_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+    eeconfig_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
 }
 /** \brief eeconfig init keyboard data block
  *
@@ -308,7 +520,7 @@ __attribute__((weak)) void eeconfig_init_kb_datablock(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_user_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+    return eeconfig_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
 }
 /** \brief eeconfig read user data block
  *
@@ -316,7 +528,7 @@ bool eeconfig_is_user_datablock_valid(void) {
  */
 void eeconfig_read_user_datablock(void *data) {
     if (eeconfig_is_user_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+        eeconfig_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_USER_DATA_SIZE));
     }
@@ -326,8 +538,8 @@ void eeconfig_read_user_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_user_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+    eeconfig_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
 }
 /** \brief eeconfig init user data block
  *
@@ -17,6 +17,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -47,8 +48,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define EECONFIG_HAPTIC (uint32_t *)32
 #define EECONFIG_RGBLIGHT_EXTENDED (uint8_t *)36
 
+#if defined(EECONFIG_CACHE_ENABLE)
+// Stored in place of EECONFIG_MAGIC_NUMBER when cached, so that data saved without the cache can be told apart
+#    define EECONFIG_CACHE_MAGIC_NUMBER (uint16_t)(~(EECONFIG_MAGIC_NUMBER))
+
+// Layout version and checksum of the eeconfig region, which are only stored when it is cached
+#    define EECONFIG_VERSION (uint8_t *)37
+#    define EECONFIG_CHECKSUM (uint32_t *)38
+
+// Bumped whenever the layout changes, with a matching migration in eeconfig.c
+#    define EECONFIG_LAYOUT_VERSION 1
+
+// Size of EEPROM being used for core data storage
+#    define EECONFIG_BASE_SIZE 42
+#else
 // Size of EEPROM being used for core data storage
-#define EECONFIG_BASE_SIZE 37
+#    define EECONFIG_BASE_SIZE 37
+#endif // EECONFIG_CACHE_ENABLE
 
 // Size of EEPROM dedicated to keyboard- and user-specific data
 #ifndef EECONFIG_KB_DATA_SIZE
@@ -86,6 +102,32 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define EECONFIG_KEYMAP_SWAP_BACKSLASH_BACKSPACE (1 << 6)
 #define EECONFIG_KEYMAP_NKRO (1 << 7)
 
+/*
+    Access to the eeconfig region. When EECONFIG_CACHE_ENABLE is set these are
+    served from a copy held in RAM, and must be used instead of the eeprom_*
+    functions for anything stored in the region so that the copy and checksum
+    are kept up to date. Accesses outside the region go straight to EEPROM.
+*/
+#if defined(EECONFIG_CACHE_ENABLE)
+uint8_t  eeconfig_read_byte(const uint8_t *addr);
+uint16_t eeconfig_read_word(const uint16_t *addr);
+uint32_t eeconfig_read_dword(const uint32_t *addr);
+void     eeconfig_read_block(void *buf, const void *addr, size_t len);
+void     eeconfig_update_byte(uint8_t *addr, uint8_t value);
+void     eeconfig_update_word(uint16_t *addr, uint16_t value);
+void     eeconfig_update_dword(uint32_t *addr, uint32_t value);
+void     eeconfig_update_block(const void *buf, void *addr, size_t len);
+#else
+#    define eeconfig_read_byte(addr) eeprom_read_byte(addr)
+#    define eeconfig_read_word(addr) eeprom_read_word(addr)
+#    define eeconfig_read_dword(addr) eeprom_read_dword(addr)
+#    define eeconfig_read_block(buf, addr, len) eeprom_read_block(buf, addr, len)
+#    define eeconfig_update_byte(addr, value) eeprom_update_byte(addr, value)
+#    define eeconfig_update_word(addr, value) eeprom_update_word(addr, value)
+#    define eeconfig_update_dword(addr, value) eeprom_update_dword(addr, value)
+#    define eeconfig_update_block(buf, addr, len) eeprom_update_block(buf, addr, len)
+#endif // EECONFIG_CACHE_ENABLE
+
 bool eeconfig_is_enabled(void);
 bool eeconfig_is_disabled(void);
 
@@ -156,13 +198,13 @@ void eeconfig_init_user_datablock(void);
     static inline void eeconfig_init_##name(void) {                     \
         dirty_##name = true;                                            \
         if (eeconfig_check_valid_##name()) {                            \
-            eeprom_read_block(&config, offset, sizeof(config));         \
+            eeconfig_read_block(&config, offset, sizeof(config));       \
             dirty_##name = false;                                       \
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flush_##name(bool force) {              \
         if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
+            eeconfig_update_block(&config, offset, sizeof(config));     \
             eeconfig_post_flush_##name();                               \
             dirty_##name = false;                                       \
         }                                                               \
@@ -87,6 +87,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -696,5 +699,17 @@ void keyboard_task(void) {
     bluetooth_task();
 #endif
 
+#ifdef VIA_ENABLE
+    via_task();
+#endif
+
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_CACHE_ENABLE)
+    eeprom_driver_task();
+#endif
+
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+    wear_leveling_task();
+#endif
+
     led_task();
 }
@@ -8,15 +8,25 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     LED_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint8_t count = g_last_hit_tracker.count;
+
+    // the animation time of each hit is the same for every LED, kept static as it can be too large for the stack
+    static uint16_t ticks[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        ticks[j] = scale16by8(g_last_hit_tracker.tick[j], led_matrix_eeconfig.speed);
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         LED_MATRIX_TEST_LED_FLAGS();
         uint8_t val = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], led_matrix_eeconfig.speed);
-            val           = effect_func(val, dx, dy, dist, tick);
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+#    ifdef LED_MATRIX_SPLASH_DISTANCE_CACHE
+            uint8_t dist = led_matrix_get_led_distance(i, g_last_hit_tracker.index[j]);
+#    else
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+#    endif
+            val = effect_func(val, dx, dy, dist, ticks[j]);
         }
         led_matrix_set_value(i, scale8(val, led_matrix_eeconfig.val));
     }
@@ -105,8 +105,72 @@ static uint32_t led_anykey_timer;
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+// age sorted ring of key hits, oldest at head
+static struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t timer[LED_HITS_TO_REMEMBER];
+} last_hit_buffer;
+
+static inline uint8_t last_hit_slot(uint8_t offset) {
+    uint16_t slot = last_hit_buffer.head + offset;
+    return slot >= LED_HITS_TO_REMEMBER ? slot - LED_HITS_TO_REMEMBER : slot;
+}
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_SPLASH_DISTANCE_CACHE
+// distance between every pair of LEDs, stored as a lower triangular matrix
+static uint8_t led_distance_cache[LED_MATRIX_LED_COUNT * (LED_MATRIX_LED_COUNT - 1) / 2];
+#endif // LED_MATRIX_SPLASH_DISTANCE_CACHE
+
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+// FNV-1a hash of every value written since the last flush
+#    define LED_FRAME_HASH_BASIS 0x811C9DC5UL
+static uint32_t led_frame_hash         = LED_FRAME_HASH_BASIS;
+static uint32_t led_frame_hash_flushed = 0;
+
+static inline void led_frame_hash_byte(uint8_t data) {
+    led_frame_hash = (led_frame_hash ^ data) * 0x01000193UL;
+}
+
+static void led_frame_hash_value(uint8_t index, uint8_t value) {
+    led_frame_hash_byte(index);
+    led_frame_hash_byte(value);
+}
+
+// what static effects and indicators are rendered from, so the task can idle until any of it changes
+typedef struct {
+    led_eeconfig_t config;
+    layer_state_t  layer_state;
+    layer_state_t  default_layer_state;
+    led_t          led_state;
+} led_idle_state_t;
+
+static led_idle_state_t led_idle_state;
+static bool             led_frame_unchanged = false;
+static bool             led_idle_wake       = false;
+
+static void led_idle_state_read(led_idle_state_t *state) {
+    memset(state, 0, sizeof(led_idle_state_t));
+    state->config              = led_matrix_eeconfig;
+    state->layer_state         = layer_state;
+    state->default_layer_state = default_layer_state;
+    state->led_state           = host_keyboard_led_state();
+}
+
+static bool led_task_idle(uint8_t effect) {
+    // only effects whose output never changes on its own can idle
+    if (effect != led_last_effect || led_idle_wake || !led_frame_unchanged || !(effect == LED_MATRIX_NONE || effect == LED_MATRIX_SOLID)) {
+        return false;
+    }
+    if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_IDLE_REFRESH_INTERVAL) {
+        return false;
+    }
+    led_idle_state_t state;
+    led_idle_state_read(&state);
+    return memcmp(&state, &led_idle_state, sizeof(led_idle_state_t)) == 0;
+}
+#endif // LED_MATRIX_SKIP_UNCHANGED_FRAMES
 
 // split led matrix
 #if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
@@ -152,6 +216,18 @@ uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef LED_MATRIX_SPLASH_DISTANCE_CACHE
+uint8_t led_matrix_get_led_distance(uint8_t led_a, uint8_t led_b) {
+    if (led_a == led_b) return 0;
+    if (led_a < led_b) {
+        uint8_t tmp = led_a;
+        led_a       = led_b;
+        led_b       = tmp;
+    }
+    return led_distance_cache[(uint16_t)led_a * (led_a - 1) / 2 + led_b];
+}
+#endif // LED_MATRIX_SPLASH_DISTANCE_CACHE
+
 void led_matrix_update_pwm_buffers(void) {
     led_matrix_driver.flush();
 }
@@ -159,6 +235,9 @@ void led_matrix_update_pwm_buffers(void) {
 void led_matrix_set_value(int index, uint8_t value) {
 #ifdef USE_CIE1931_CURVE
     value = pgm_read_byte(&CIE1931_CURVE[value]);
+#endif
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    led_frame_hash_value(index, value);
 #endif
     led_matrix_driver.set_value(index, value);
 }
@@ -168,6 +247,9 @@ void led_matrix_set_value_all(uint8_t value) {
     for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++)
         led_matrix_set_value(i, value);
 #else
+#    ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    led_frame_hash_value(NO_LED, value);
+#    endif
 #    ifdef USE_CIE1931_CURVE
     led_matrix_driver.set_value_all(pgm_read_byte(&CIE1931_CURVE[value]));
 #    else
@@ -183,6 +265,10 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
 #if LED_MATRIX_TIMEOUT > 0
     led_anykey_timer = 0;
 #endif // LED_MATRIX_TIMEOUT > 0
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    // indicators may depend on state that changes with key presses
+    led_idle_wake = true;
+#endif // LED_MATRIX_SKIP_UNCHANGED_FRAMES
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     uint8_t led[LED_HITS_TO_REMEMBER];
@@ -197,21 +283,19 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    uint32_t now = sync_timer_read32();
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        uint8_t slot;
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            slot = last_hit_slot(last_hit_buffer.count);
+            last_hit_buffer.count++;
+        } else {
+            // overwrite the oldest hit
+            slot                 = last_hit_buffer.head;
+            last_hit_buffer.head = last_hit_slot(1);
+        }
+        last_hit_buffer.index[slot] = led[i];
+        last_hit_buffer.timer[slot] = now;
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
@@ -232,9 +316,9 @@ static bool led_matrix_none(effect_params_t *params) {
 }
 
 static void led_task_timers(void) {
-#if defined(LED_MATRIX_KEYREACTIVE_ENABLED) || LED_MATRIX_TIMEOUT > 0
+#if LED_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
-#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED) || LED_MATRIX_TIMEOUT > 0
+#endif // LED_MATRIX_TIMEOUT > 0
     led_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -247,22 +331,13 @@ static void led_task_timers(void) {
         }
     }
 #endif // LED_MATRIX_TIMEOUT > 0
-
-    // Update double buffer last hit timers
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void led_task_sync(void) {
+static void led_task_sync(uint8_t effect) {
     eeconfig_flush_led_matrix(false);
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    if (led_task_idle(effect)) return;
+#endif // LED_MATRIX_SKIP_UNCHANGED_FRAMES
     // next task
     if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
 }
@@ -273,8 +348,26 @@ static void led_task_start(void) {
 
     // update double buffers
     g_led_timer = led_timer_buffer;
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    led_idle_state_read(&led_idle_state);
+    led_idle_wake = false;
+#endif // LED_MATRIX_SKIP_UNCHANGED_FRAMES
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    // drop hits which are too old to be tracked
+    while (last_hit_buffer.count && (g_led_timer - last_hit_buffer.timer[last_hit_buffer.head]) >= UINT16_MAX) {
+        last_hit_buffer.head = last_hit_slot(1);
+        last_hit_buffer.count--;
+    }
+
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        uint8_t slot                = last_hit_slot(i);
+        uint8_t led                 = last_hit_buffer.index[slot];
+        g_last_hit_tracker.x[i]     = g_led_config.point[led].x;
+        g_last_hit_tracker.y[i]     = g_led_config.point[led].y;
+        g_last_hit_tracker.index[i] = led;
+        g_last_hit_tracker.tick[i]  = g_led_timer - last_hit_buffer.timer[slot];
+    }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -335,12 +428,26 @@ static void led_task_render(uint8_t effect) {
 }
 
 static void led_task_flush(uint8_t effect) {
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    // skip the driver flush if the same values were written as last frame
+    bool changed = (led_frame_hash != led_frame_hash_flushed) || (effect != led_last_effect) || (led_matrix_eeconfig.enable != led_last_enable);
+    led_frame_hash_flushed = led_frame_hash;
+    led_frame_hash         = LED_FRAME_HASH_BASIS;
+    led_frame_unchanged    = !changed;
+#endif // LED_MATRIX_SKIP_UNCHANGED_FRAMES
+
     // update last trackers after the first full render so we can init over several frames
     led_last_effect = effect;
     led_last_enable = led_matrix_eeconfig.enable;
 
     // update pwm buffers
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+    if (changed) {
+        led_matrix_update_pwm_buffers();
+    }
+#else
     led_matrix_update_pwm_buffers();
+#endif
 
     // next task
     led_task_state = SYNCING;
@@ -374,7 +481,7 @@ void led_matrix_task(void) {
             led_task_flush(effect);
             break;
         case SYNCING:
-            led_task_sync();
+            led_task_sync(effect);
             break;
     }
 }
@@ -427,11 +534,18 @@ void led_matrix_init(void) {
         g_last_hit_tracker.tick[i] = UINT16_MAX;
     }
 
+    last_hit_buffer.head  = 0;
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_SPLASH_DISTANCE_CACHE
+    for (uint8_t b = 1; b < LED_MATRIX_LED_COUNT; b++) {
+        for (uint8_t a = 0; a < b; a++) {
+            int16_t dx                                        = g_led_config.point[b].x - g_led_config.point[a].x;
+            int16_t dy                                        = g_led_config.point[b].y - g_led_config.point[a].y;
+            led_distance_cache[(uint16_t)b * (b - 1) / 2 + a] = sqrt16(dx * dx + dy * dy);
+        }
+    }
+#endif // LED_MATRIX_SPLASH_DISTANCE_CACHE
 
     if (!eeconfig_is_enabled()) {
         dprintf("led_matrix_init_drivers eeconfig is not enabled.\n");
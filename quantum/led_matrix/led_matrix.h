@@ -41,6 +41,10 @@
 #    define LED_MATRIX_LED_FLUSH_LIMIT 16
 #endif
 
+#ifndef LED_MATRIX_IDLE_REFRESH_INTERVAL
+#    define LED_MATRIX_IDLE_REFRESH_INTERVAL 1000
+#endif
+
 #ifndef LED_MATRIX_LED_PROCESS_LIMIT
 #    define LED_MATRIX_LED_PROCESS_LIMIT (LED_MATRIX_LED_COUNT + 4) / 5
 #endif
@@ -110,6 +114,10 @@ void eeconfig_debug_led_matrix(void);
 uint8_t led_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i);
 uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
 
+#ifdef LED_MATRIX_SPLASH_DISTANCE_CACHE
+uint8_t led_matrix_get_led_distance(uint8_t led_a, uint8_t led_b);
+#endif
+
 void led_matrix_set_value(int index, uint8_t value);
 void led_matrix_set_value_all(uint8_t value);
 
@@ -37,6 +37,9 @@
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
 #endif // LED_HITS_TO_REMEMBER
+#if LED_HITS_TO_REMEMBER > 255
+#    error "LED_HITS_TO_REMEMBER must not be greater than 255"
+#endif
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 typedef struct PACKED {
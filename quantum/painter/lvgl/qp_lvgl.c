@@ -3,10 +3,18 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_lvgl.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
 #include "timer.h"
 #include "deferred_exec.h"
 #include "lvgl.h"
 
+#if QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+#    define QP_LVGL_NUM_BUFFERS 2
+#else
+#    define QP_LVGL_NUM_BUFFERS 1
+#endif
+
 typedef struct lvgl_state_t {
     uint8_t        fnc_id; // Ideally this should be the pointer of the function to run
     uint16_t       delay_ms;
@@ -19,15 +27,66 @@ static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_ta
 painter_device_t selected_display = NULL;
 void *           color_buffer     = NULL;
 
+#if QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+// Whether a background flush has been started, and whether its transfer has completed
+static bool          flush_pending  = false;
+static volatile bool flush_complete = false;
+
+// Invoked from the comms layer -- generally the SPI DMA completion interrupt -- once the pixel data has been sent
+static void qp_lvgl_flush_complete(void *cb_arg) {
+    flush_complete = true;
+    lv_disp_flush_ready((lv_disp_drv_t *)cb_arg);
+}
+
+// Waits for any background flush to finish, then lets the display complete it
+static void qp_lvgl_finish_flush(void) {
+    if (flush_pending) {
+        while (!flush_complete) {
+        }
+        flush_pending = false;
+        qp_flush(selected_display);
+    }
+}
+#endif // QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_flush
 
 void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     if (selected_display) {
         uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
+#if QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+        qp_lvgl_finish_flush();
+
+        // Start the transfer and leave it running -- LVGL carries on rendering into the other buffer in the meantime,
+        // and is told that this one is free again from the transfer's completion callback. The comms are released
+        // straight away, so the bus is handed back as soon as the transfer completes.
+        painter_driver_t *driver = (painter_driver_t *)selected_display;
+        if (qp_comms_start(selected_display)) {
+            flush_complete = false;
+            driver->driver_vtable->viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
+            driver->driver_vtable->pixdata(selected_display, (void *)color_p, number_pixels);
+            if (qp_comms_notify(selected_display, qp_lvgl_flush_complete, disp)) {
+                if (qp_comms_release(selected_display)) {
+                    flush_pending = true;
+                    return;
+                }
+
+                // The comms layer can't release the bus in the background, so wait for the transfer instead
+                qp_comms_stop(selected_display);
+                qp_flush(selected_display);
+                return;
+            }
+
+            // The comms layer can't signal completion, so wait for the transfer instead
+            qp_comms_stop(selected_display);
+            qp_flush(selected_display);
+        }
+#else
         qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
         qp_pixdata(selected_display, (void *)color_p, number_pixels);
         qp_flush(selected_display);
+#endif
         lv_disp_flush_ready(disp);
     }
 }
@@ -93,25 +152,35 @@ bool qp_lvgl_attach(painter_device_t device) {
     // Init LVGL
     lv_init();
 
-    // Set up lvgl display buffer
+    uint16_t panel_width, panel_height, offset_x, offset_y;
+    qp_get_geometry(device, &panel_width, &panel_height, NULL, &offset_x, &offset_y);
+
+    // Set up lvgl display buffer(s), each a fraction of the screen size, within the configured RAM limit and no smaller
+    // than a single line
     static lv_disp_draw_buf_t draw_buf;
-    // Allocate a buffer for 1/10 screen size
-    const size_t count_required = driver->panel_width * driver->panel_height / 10;
-    color_buffer                = color_buffer ? realloc(color_buffer, sizeof(lv_color_t) * count_required) : malloc(sizeof(lv_color_t) * count_required);
+    size_t                    count_required = (size_t)panel_width * panel_height / QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR;
+#if QUANTUM_PAINTER_LVGL_BUFFER_MAX_BYTES > 0
+    count_required = QP_MIN(count_required, (QUANTUM_PAINTER_LVGL_BUFFER_MAX_BYTES) / (sizeof(lv_color_t) * QP_LVGL_NUM_BUFFERS));
+#endif
+    count_required = QP_MAX(count_required, panel_width);
+
+    const size_t bytes_required = sizeof(lv_color_t) * count_required * QP_LVGL_NUM_BUFFERS;
+    color_buffer                = color_buffer ? realloc(color_buffer, bytes_required) : malloc(bytes_required);
     if (!color_buffer) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
         qp_lvgl_detach();
         return false;
     }
-    memset(color_buffer, 0, sizeof(lv_color_t) * count_required);
+    memset(color_buffer, 0, bytes_required);
     // Initialize the display buffer.
+#if QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+    lv_disp_draw_buf_init(&draw_buf, color_buffer, ((lv_color_t *)color_buffer) + count_required, count_required);
+#else
     lv_disp_draw_buf_init(&draw_buf, color_buffer, NULL, count_required);
+#endif
 
     selected_display = device;
 
-    uint16_t panel_width, panel_height, offset_x, offset_y;
-    qp_get_geometry(selected_display, &panel_width, &panel_height, NULL, &offset_x, &offset_y);
-
     // Setting up display driver
     static lv_disp_drv_t disp_drv;     /*Descriptor of a display driver*/
     lv_disp_drv_init(&disp_drv);       /*Basic initialization*/
@@ -128,6 +197,10 @@ bool qp_lvgl_attach(painter_device_t device) {
 // Quantum Painter LVGL Integration API: qp_lvgl_detach
 
 void qp_lvgl_detach(void) {
+#if QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+    // The buffer being transmitted must not be freed until the transfer completes
+    qp_lvgl_finish_flush();
+#endif
     for (int i = 0; i < 2; ++i) {
         cancel_deferred_exec_advanced(lvgl_executors, 2, lvgl_states[i].defer_token);
     }
@@ -142,6 +215,13 @@ void qp_lvgl_detach(void) {
 // Quantum Painter LVGL Integration Internal: qp_lvgl_internal_tick
 
 void qp_lvgl_internal_tick(void) {
+#if QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+    // Let the display complete a background flush once its transfer has finished
+    if (flush_pending && flush_complete) {
+        qp_lvgl_finish_flush();
+    }
+#endif
+
     static uint32_t last_lvgl_exec = 0;
     deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
 }
@@ -7,6 +7,36 @@
 #include "qp.h"
 #include "lvgl.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter - LVGL config
+
+#ifndef QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER
+/**
+ * @def This controls whether LVGL is given two draw buffers. When enabled, LVGL renders into one buffer while the other
+ *      is transmitted to the display in the background, with completion signalled from the SPI DMA interrupt. Requires
+ *      a display whose comms layer supports asynchronous transfers (SPI on ChibiOS, with
+ *      QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER enabled) -- otherwise each flush blocks until complete.
+ */
+#    define QUANTUM_PAINTER_LVGL_DOUBLE_BUFFER FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR
+/**
+ * @def This controls the size of each LVGL draw buffer, as a fraction of the display size. The default of 10 allocates
+ *      a tenth of the screen per buffer. Larger buffers mean fewer flushes, at the cost of RAM.
+ */
+#    define QUANTUM_PAINTER_LVGL_BUFFER_DIVISOR 10
+#endif
+
+#ifndef QUANTUM_PAINTER_LVGL_BUFFER_MAX_BYTES
+/**
+ * @def This limits the total amount of RAM (in bytes) allocated to LVGL draw buffers, shared between both buffers when
+ *      double-buffering. Buffers are never made smaller than a single line of the display. Defaults to 0, which
+ *      applies no limit.
+ */
+#    define QUANTUM_PAINTER_LVGL_BUFFER_MAX_BYTES 0
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter - LVGL External API
 
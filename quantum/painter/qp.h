@@ -72,6 +72,39 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether or not a second pixel data buffer is allocated. When enabled, a completed buffer is handed
+ *      off to the display's comms layer (which may transmit it asynchronously, such as SPI DMA on ChibiOS) while the
+ *      next block of pixels is decoded into the other buffer. Doubles the RAM used by the pixel data buffer.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the amount of RAM (in bytes) used to cache decoded font glyphs in the display's native pixel
+ *      format. Cached glyphs are sent directly to the display without being decoded again, which is significantly
+ *      faster for text that is redrawn frequently. Defaults to 0, which disables the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs held in the glyph cache, if enabled. Must be no more than 255.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#endif
+
+#ifndef QUANTUM_PAINTER_FLASH_READ_AHEAD_SIZE
+/**
+ * @def This controls the size of the read-ahead cache used when streaming images and fonts from external SPI flash.
+ *      Each loaded image and font has its own cache, so increasing this number increases the amount of RAM required.
+ */
+#    define QUANTUM_PAINTER_FLASH_READ_AHEAD_SIZE 64
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -318,6 +351,20 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads an image stored in external SPI flash.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image.
+ *
+ * @param address[in] the address of the image data within the external flash
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint32_t address);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -405,6 +452,32 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads a font stored in external SPI flash.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font.
+ *
+ * @param address[in] the address of the font data within the external flash
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint32_t address);
+
+/**
+ * Looks up the address of an asset within an asset pack stored in external SPI flash.
+ *
+ * @note Asset packs are generated using `qmk painter-pack-assets`.
+ *
+ * @param pack_address[in] the address of the asset pack within the external flash
+ * @param index[in] the index of the asset within the pack
+ * @param asset_address[out] the address of the asset, usable with \ref qp_load_image_flash or \ref qp_load_font_flash
+ * @return true if the asset was found
+ * @return false if the pack was invalid, or the index was out of range
+ */
+bool qp_flash_asset_address(uint32_t pack_address, uint16_t index, uint32_t *asset_address);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
@@ -6,6 +6,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
 
+// The device whose comms are currently started, so that they can be suspended while another device uses a shared bus
+static painter_device_t qp_comms_active_device = NULL;
+
 bool qp_comms_init(painter_device_t device) {
     painter_driver_t *driver = (painter_driver_t *)device;
     if (!driver->validate_ok) {
@@ -23,7 +26,12 @@ bool qp_comms_start(painter_device_t device) {
         return false;
     }
 
-    return driver->comms_vtable->comms_start(device);
+    if (!driver->comms_vtable->comms_start(device)) {
+        return false;
+    }
+
+    qp_comms_active_device = device;
+    return true;
 }
 
 void qp_comms_stop(painter_device_t device) {
@@ -34,6 +42,21 @@ void qp_comms_stop(painter_device_t device) {
     }
 
     driver->comms_vtable->comms_stop(device);
+    if (qp_comms_active_device == device) {
+        qp_comms_active_device = NULL;
+    }
+}
+
+painter_device_t qp_comms_suspend(void) {
+    painter_device_t device = qp_comms_active_device;
+    if (device) {
+        qp_comms_stop(device);
+    }
+    return device;
+}
+
+bool qp_comms_resume(painter_device_t device) {
+    return device == NULL || qp_comms_start(device);
 }
 
 uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
@@ -46,6 +69,55 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+uint32_t qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Fall back to a blocking send if the comms layer has no asynchronous support
+    if (driver->comms_vtable->comms_send_async == NULL) {
+        return driver->comms_vtable->comms_send(device, data, byte_count);
+    }
+
+    return driver->comms_vtable->comms_send_async(device, data, byte_count);
+}
+
+bool qp_comms_notify(painter_device_t device, painter_comms_notify_callback callback, void *cb_arg) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_comms_notify: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Callers are expected to fall back to waiting for completion if the comms layer cannot notify them
+    if (driver->comms_vtable->comms_notify == NULL) {
+        return false;
+    }
+
+    return driver->comms_vtable->comms_notify(device, callback, cb_arg);
+}
+
+bool qp_comms_release(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_comms_release: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Callers are expected to fall back to qp_comms_stop() if the comms layer cannot release the bus in the background
+    if (driver->comms_vtable->comms_release == NULL) {
+        return false;
+    }
+
+    driver->comms_vtable->comms_release(device);
+    if (qp_comms_active_device == device) {
+        qp_comms_active_device = NULL;
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -11,10 +11,15 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
 
-bool     qp_comms_init(painter_device_t device);
-bool     qp_comms_start(painter_device_t device);
-void     qp_comms_stop(painter_device_t device);
-uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
+bool             qp_comms_init(painter_device_t device);
+bool             qp_comms_start(painter_device_t device);
+void             qp_comms_stop(painter_device_t device);
+painter_device_t qp_comms_suspend(void);
+bool             qp_comms_resume(painter_device_t device);
+uint32_t         qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
+uint32_t         qp_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count);
+bool             qp_comms_notify(painter_device_t device, painter_comms_notify_callback callback, void* cb_arg);
+bool             qp_comms_release(painter_device_t device);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
@@ -10,7 +10,14 @@
 // Quantum Painter utility functions
 
 // Global variable used for native pixel data streaming.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+extern uint8_t* qp_internal_global_pixdata_buffer;
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+// Transmits the first native_pixel_count pixels of the global pixdata buffer, then swaps to the alternate buffer if double-buffering is enabled.
+bool qp_internal_send_pixdata_buffer(painter_device_t device, uint32_t native_pixel_count);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -27,6 +34,9 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
+// As above, but clipped to the panel, for spans computed from a center point which may lie partially off-screen.
+bool qp_internal_fillrect_clipped_impl(painter_device_t device, int16_t l, int16_t t, int16_t r, int16_t b);
+
 // Convert from input pixel data + palette to equivalent pixels
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
 typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
@@ -92,4 +102,7 @@ typedef struct qp_internal_byte_output_state_t {
 
 bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 
+// Equivalent to qp_internal_decode_palette() using qp_internal_pixel_appender(), but appends each input byte's pixels as a batch.
+bool qp_internal_decode_palette_to_pixdata(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_state_t* output_state);
+
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
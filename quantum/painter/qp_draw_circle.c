@@ -8,114 +8,107 @@
 #include "qp_draw.h"
 
 // Utilize 8-way symmetry to draw circles
-static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx_start, uint16_t offsetx_end, uint16_t offsety, bool filled) {
     /*
     Circles have the property of 8-way symmetry, so eight pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
     represented by [centerx,centery].
 
-    For filled circles, we can draw horizontal lines between each pair of
-    pixels with the same final value of y.
+    Rather than drawing each computed point individually, this is invoked with
+    a run of consecutive values of offsetx which share the same offsety. Each
+    run maps to horizontal spans at centery+/-offsety, and vertical spans at
+    centerx+/-offsety, each of which is sent to the display as a single
+    viewport + pixdata transfer.
+
+    For filled circles, only the widest horizontal span is required for each
+    of the rows at centery+/-offsety, and the rows at centery+/-offsetx all
+    share the same width -- so the whole run can be filled using rects.
 
     Two special cases exist and have been optimized:
-    1) offsetx == offsety (the final point), makes half the coordinates
-    equivalent, so we can omit them (and the corresponding fill lines)
-    2) offsetx == 0 (the starting point) means that some horizontal lines
-    would be a single pixel in length, so we write individual pixels instead.
-    This also makes half the symmetrical points identical to their twins,
-    so we only need four points or two points and one line
+    1) offsetx_start == 0 (the starting run) means that each pair of mirrored
+    spans meet in the middle, so they're merged into one
+    2) offsety == 0 (zero radius) means that mirrored rows and columns are
+    identical, so we only draw one of them
     */
 
-    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
-    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
+    int16_t xps = ((int16_t)centerx) + ((int16_t)offsetx_start);
+    int16_t xpe = ((int16_t)centerx) + ((int16_t)offsetx_end);
+    int16_t xms = ((int16_t)centerx) - ((int16_t)offsetx_start);
+    int16_t xme = ((int16_t)centerx) - ((int16_t)offsetx_end);
     int16_t xpy = ((int16_t)centerx) + ((int16_t)offsety);
     int16_t xmy = ((int16_t)centerx) - ((int16_t)offsety);
-    int16_t ypx = ((int16_t)centery) + ((int16_t)offsetx);
-    int16_t ymx = ((int16_t)centery) - ((int16_t)offsetx);
+    int16_t yps = ((int16_t)centery) + ((int16_t)offsetx_start);
+    int16_t ype = ((int16_t)centery) + ((int16_t)offsetx_end);
+    int16_t yms = ((int16_t)centery) - ((int16_t)offsetx_start);
+    int16_t yme = ((int16_t)centery) - ((int16_t)offsetx_end);
     int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
     int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
 
-    if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, centerx, ypy)) {
+    if (filled) {
+        // Widest rows at the top and bottom of the run
+        if (!qp_internal_fillrect_clipped_impl(device, xme, ypy, xpe, ypy)) {
             return false;
         }
-        if (!qp_internal_setpixel_impl(device, centerx, ymy)) {
+        if (offsety != 0 && !qp_internal_fillrect_clipped_impl(device, xme, ymy, xpe, ymy)) {
             return false;
         }
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, centery, xmy, centery)) {
+
+        // Rows at centery+/-offsetx all have the same width, so fill them as rects
+        if (offsetx_start == 0) {
+            if (!qp_internal_fillrect_clipped_impl(device, xmy, yme, xpy, ype)) {
                 return false;
             }
         } else {
-            if (!qp_internal_setpixel_impl(device, xpy, centery)) {
+            if (!qp_internal_fillrect_clipped_impl(device, xmy, yps, xpy, ype)) {
                 return false;
             }
-            if (!qp_internal_setpixel_impl(device, xmy, centery)) {
+            if (!qp_internal_fillrect_clipped_impl(device, xmy, yme, xpy, yms)) {
                 return false;
             }
         }
-    } else if (offsetx == offsety) {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypy, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymy, xmy, ymy)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymy)) {
-                return false;
-            }
+    } else if (offsetx_start == 0) {
+        // Horizontal spans
+        if (!qp_internal_fillrect_clipped_impl(device, xme, ypy, xpe, ypy)) {
+            return false;
+        }
+        if (offsety != 0 && !qp_internal_fillrect_clipped_impl(device, xme, ymy, xpe, ymy)) {
+            return false;
         }
 
+        // Vertical spans
+        if (!qp_internal_fillrect_clipped_impl(device, xpy, yme, xpy, ype)) {
+            return false;
+        }
+        if (offsety != 0 && !qp_internal_fillrect_clipped_impl(device, xmy, yme, xmy, ype)) {
+            return false;
+        }
     } else {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypx, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymx, xmy, ymx)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymx)) {
-                return false;
-            }
+        // Horizontal spans
+        if (!qp_internal_fillrect_clipped_impl(device, xps, ypy, xpe, ypy)) {
+            return false;
+        }
+        if (!qp_internal_fillrect_clipped_impl(device, xme, ypy, xms, ypy)) {
+            return false;
+        }
+        if (!qp_internal_fillrect_clipped_impl(device, xps, ymy, xpe, ymy)) {
+            return false;
+        }
+        if (!qp_internal_fillrect_clipped_impl(device, xme, ymy, xms, ymy)) {
+            return false;
+        }
+
+        // Vertical spans
+        if (!qp_internal_fillrect_clipped_impl(device, xpy, yps, xpy, ype)) {
+            return false;
+        }
+        if (!qp_internal_fillrect_clipped_impl(device, xpy, yme, xpy, yms)) {
+            return false;
+        }
+        if (!qp_internal_fillrect_clipped_impl(device, xmy, yps, xmy, ype)) {
+            return false;
+        }
+        if (!qp_internal_fillrect_clipped_impl(device, xmy, yme, xmy, yms)) {
+            return false;
         }
     }
 
@@ -138,34 +131,44 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
     int16_t ycalc = (int16_t)radius;
     int16_t err   = ((5 - (radius >> 2)) >> 2);
 
-    qp_internal_fill_pixdata(device, (radius * 2) + 1, hue, sat, val);
+    // Filled circles are drawn using rects up to the full width of the circle and half its height
+    uint32_t diameter = (radius * 2) + 1;
+    qp_internal_fill_pixdata(device, filled ? diameter * (radius + 1) : diameter, hue, sat, val);
 
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_circle: fail (could not start comms)\n");
         return false;
     }
 
-    bool ret = true;
-    if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
-        ret = false;
-    }
+    // Track the start of the current run of points that share the same value of ycalc
+    bool    ret       = true;
+    int16_t run_start = xcalc;
+    while (xcalc < ycalc) {
+        int16_t prev_xcalc = xcalc;
+        int16_t prev_ycalc = ycalc;
+        xcalc++;
+        if (err < 0) {
+            err += (xcalc << 1) + 1;
+        } else {
+            ycalc--;
+            err += ((xcalc - ycalc) << 1) + 1;
+        }
 
-    if (ret) {
-        while (xcalc < ycalc) {
-            xcalc++;
-            if (err < 0) {
-                err += (xcalc << 1) + 1;
-            } else {
-                ycalc--;
-                err += ((xcalc - ycalc) << 1) + 1;
-            }
-            if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
+        // If ycalc changed, draw the run that just finished
+        if (ycalc != prev_ycalc) {
+            if (!qp_circle_helper_impl(device, x, y, run_start, prev_xcalc, prev_ycalc, filled)) {
                 ret = false;
                 break;
             }
+            run_start = xcalc;
         }
     }
 
+    // Draw the final run
+    if (ret && !qp_circle_helper_impl(device, x, y, run_start, xcalc, ycalc, filled)) {
+        ret = false;
+    }
+
     qp_dprintf("qp_circle: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
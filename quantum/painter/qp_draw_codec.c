@@ -49,6 +49,47 @@ bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, u
     return true;
 }
 
+bool qp_internal_decode_palette_to_pixdata(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_state_t* output_state) {
+    painter_driver_t* driver           = (painter_driver_t*)device;
+    const uint8_t     pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t     pixels_per_byte  = 8 / bits_per_pixel;
+    uint32_t          remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
+    uint8_t           indices[8];
+    while (remaining_pixels > 0) {
+        int16_t byteval = input_callback(input_arg);
+        if (byteval < 0) {
+            return false;
+        }
+
+        // Unpack all the palette indices held in this byte
+        uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
+        for (uint8_t q = 0; q < loop_pixels; ++q) {
+            indices[q] = byteval & pixel_bitmask;
+            byteval >>= bits_per_pixel;
+        }
+        remaining_pixels -= loop_pixels;
+
+        // Append them as a batch, transmitting whenever the buffer fills up
+        uint8_t appended = 0;
+        while (appended < loop_pixels) {
+            uint8_t batch = QP_MIN(loop_pixels - appended, output_state->max_pixels - output_state->pixel_write_pos);
+            if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, palette, output_state->pixel_write_pos, batch, &indices[appended])) {
+                return false;
+            }
+            output_state->pixel_write_pos += batch;
+            appended += batch;
+
+            if (output_state->pixel_write_pos == output_state->max_pixels) {
+                if (!qp_internal_send_pixdata_buffer(device, output_state->pixel_write_pos)) {
+                    return false;
+                }
+                output_state->pixel_write_pos = 0;
+            }
+        }
+    }
+    return true;
+}
+
 bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg) {
     return qp_internal_decode_recolor(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_pixel_white, qp_pixel_black, output_callback, output_arg);
 }
@@ -135,7 +176,7 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
 
     // If we've hit the transmit limit, send out the entire buffer and reset the write position
     if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+        if (!qp_internal_send_pixdata_buffer(state->device, state->pixel_write_pos)) {
             return false;
         }
         state->pixel_write_pos = 0;
@@ -154,8 +195,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
 
     // If we've hit the transmit limit, send out the entire buffer and reset the write position
     if (state->byte_write_pos == state->max_bytes) {
-        painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+        if (!qp_internal_send_pixdata_buffer(state->device, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
         state->byte_write_pos = 0;
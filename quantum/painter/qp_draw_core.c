@@ -19,8 +19,14 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //       **** very likely get artifacts rendered to the screen as a result.                                       ****
 //
 
-// Buffer used for transmitting native pixel data to the downstream device.
+// Buffer used for transmitting native pixel data to the downstream device. If double-buffered, the global pointer refers
+// to the buffer currently being filled, while the other may still be in flight to the display.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t *                                      qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -41,6 +47,17 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+// Transmits the global pixdata buffer, swapping to the alternate buffer so that it can be filled while the transmission is in progress.
+bool qp_internal_send_pixdata_buffer(painter_device_t device, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    bool              ret    = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // The comms layer waits for any previous transfer before starting a new one, so the alternate buffer is free by now
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+#endif
+    return ret;
+}
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -185,25 +202,32 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         return false;
     }
 
-    qp_internal_fill_pixdata(device, 1, hue, sat, val);
+    int16_t dx = abs(((int16_t)x1) - ((int16_t)x0));
+    int16_t dy = -abs(((int16_t)y1) - ((int16_t)y0));
+
+    // The longest possible run of pixels is along the major axis
+    qp_internal_fill_pixdata(device, QP_MAX(dx, -dy) + 1, hue, sat, val);
 
     // draw angled line using Bresenham's algo
     int16_t x      = ((int16_t)x0);
     int16_t y      = ((int16_t)y0);
     int16_t slopex = ((int16_t)x0) < ((int16_t)x1) ? 1 : -1;
     int16_t slopey = ((int16_t)y0) < ((int16_t)y1) ? 1 : -1;
-    int16_t dx     = abs(((int16_t)x1) - ((int16_t)x0));
-    int16_t dy     = -abs(((int16_t)y1) - ((int16_t)y0));
 
     int16_t e  = dx + dy;
     int16_t e2 = 2 * e;
 
+    // Consecutive pixels which only move along the major axis are batched into a single run, which is sent to the
+    // display as one viewport + pixdata transfer instead of one per pixel.
+    bool    x_major = dx >= -dy;
+    int16_t run_x   = x;
+    int16_t run_y   = y;
+
     bool ret = true;
     while (x != x1 || y != y1) {
-        if (!qp_internal_setpixel_impl(device, x, y)) {
-            ret = false;
-            break;
-        }
+        int16_t prev_x = x;
+        int16_t prev_y = y;
+
         e2 = 2 * e;
         if (e2 >= dy) {
             e += dy;
@@ -213,9 +237,19 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
             e += dx;
             y += slopey;
         }
+
+        // If the minor axis changed, the current run has ended
+        if (x_major ? (y != prev_y) : (x != prev_x)) {
+            if (!qp_internal_fillrect_helper_impl(device, run_x, run_y, prev_x, prev_y)) {
+                ret = false;
+                break;
+            }
+            run_x = x;
+            run_y = y;
+        }
     }
-    // draw the last pixel
-    if (!qp_internal_setpixel_impl(device, x, y)) {
+    // draw the last run
+    if (ret && !qp_internal_fillrect_helper_impl(device, run_x, run_y, x, y)) {
         ret = false;
     }
 
@@ -250,6 +284,24 @@ bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t left, ui
     return true;
 }
 
+bool qp_internal_fillrect_clipped_impl(painter_device_t device, int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    uint16_t width;
+    uint16_t height;
+    qp_get_geometry(device, &width, &height, NULL, NULL, NULL);
+
+    int16_t l = QP_MIN(left, right);
+    int16_t r = QP_MAX(left, right);
+    int16_t t = QP_MIN(top, bottom);
+    int16_t b = QP_MAX(top, bottom);
+
+    // Nothing to draw if the rect lies entirely off-screen
+    if (r < 0 || b < 0 || l >= (int16_t)width || t >= (int16_t)height) {
+        return true;
+    }
+
+    return qp_internal_fillrect_helper_impl(device, QP_MAX(l, 0), QP_MAX(t, 0), QP_MIN(r, (int16_t)width - 1), QP_MIN(b, (int16_t)height - 1));
+}
+
 bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint8_t hue, uint8_t sat, uint8_t val, bool filled) {
     qp_dprintf("qp_rect(%d, %d, %d, %d): entry\n", (int)left, (int)top, (int)right, (int)bottom);
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -6,49 +6,96 @@
 #include "qp_comms.h"
 #include "qp_draw.h"
 
-// Utilize 4-way symmetry to draw an ellipse
-static bool qp_ellipse_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+// Utilize 4-way symmetry to draw a run of horizontally-adjacent points of an ellipse
+static bool qp_ellipse_hspan_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx_start, uint16_t offsetx_end, uint16_t offsety, bool filled) {
     /*
     Ellipses have the property of 4-way symmetry, so four pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
     represented by [centerx,centery].
 
-    For filled ellipses, we can draw horizontal lines between each pair of
-    pixels with the same final value of y.
+    Rather than drawing each computed point individually, this is invoked with
+    a run of consecutive values of offsetx which share the same offsety, which
+    are drawn as horizontal spans -- one viewport + pixdata transfer each.
 
-    When offsetx == 0 only two pixels can be drawn for filled or unfilled ellipses
+    For filled ellipses, only the widest span is required for each row.
+
+    When offsetx_start == 0 the mirrored spans meet in the middle and are
+    merged, and when offsety == 0 the mirrored rows are identical so only one
+    of them is drawn.
     */
 
-    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
-    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
+    int16_t xps = ((int16_t)centerx) + ((int16_t)offsetx_start);
+    int16_t xpe = ((int16_t)centerx) + ((int16_t)offsetx_end);
+    int16_t xms = ((int16_t)centerx) - ((int16_t)offsetx_start);
+    int16_t xme = ((int16_t)centerx) - ((int16_t)offsetx_end);
     int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
     int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
 
-    if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
+    if (filled || offsetx_start == 0) {
+        if (!qp_internal_fillrect_clipped_impl(device, xme, ypy, xpe, ypy)) {
+            return false;
+        }
+        if (offsety > 0 && !qp_internal_fillrect_clipped_impl(device, xme, ymy, xpe, ymy)) {
+            return false;
+        }
+    } else {
+        if (!qp_internal_fillrect_clipped_impl(device, xps, ypy, xpe, ypy)) {
             return false;
         }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
+        if (!qp_internal_fillrect_clipped_impl(device, xme, ypy, xms, ypy)) {
             return false;
         }
-    } else if (filled) {
-        if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
+        if (offsety > 0 && !qp_internal_fillrect_clipped_impl(device, xps, ymy, xpe, ymy)) {
             return false;
         }
-        if (offsety > 0 && !qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
+        if (offsety > 0 && !qp_internal_fillrect_clipped_impl(device, xme, ymy, xms, ymy)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Utilize 4-way symmetry to draw a run of vertically-adjacent points of an ellipse
+static bool qp_ellipse_vspan_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety_start, uint16_t offsety_end, bool filled) {
+    /*
+    As above, but for a run of consecutive values of offsety which share the
+    same offsetx, drawn as vertical spans. For filled ellipses all the rows in
+    the run have the same width, so they're filled as rects instead.
+    */
+
+    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
+    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
+    int16_t yps = ((int16_t)centery) + ((int16_t)offsety_start);
+    int16_t ype = ((int16_t)centery) + ((int16_t)offsety_end);
+    int16_t yms = ((int16_t)centery) - ((int16_t)offsety_start);
+    int16_t yme = ((int16_t)centery) - ((int16_t)offsety_end);
+
+    if (filled) {
+        if (offsety_start == 0) {
+            return qp_internal_fillrect_clipped_impl(device, xmx, yme, xpx, ype);
+        }
+        return qp_internal_fillrect_clipped_impl(device, xmx, yps, xpx, ype) && qp_internal_fillrect_clipped_impl(device, xmx, yme, xpx, yms);
+    }
+
+    if (offsety_start == 0) {
+        if (!qp_internal_fillrect_clipped_impl(device, xpx, yme, xpx, ype)) {
+            return false;
+        }
+        if (offsetx > 0 && !qp_internal_fillrect_clipped_impl(device, xmx, yme, xmx, ype)) {
             return false;
         }
     } else {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
+        if (!qp_internal_fillrect_clipped_impl(device, xpx, yps, xpx, ype)) {
             return false;
         }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
+        if (!qp_internal_fillrect_clipped_impl(device, xpx, yme, xpx, yms)) {
             return false;
         }
-        if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
+        if (offsetx > 0 && !qp_internal_fillrect_clipped_impl(device, xmx, yps, xmx, ype)) {
             return false;
         }
-        if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
+        if (offsetx > 0 && !qp_internal_fillrect_clipped_impl(device, xmx, yme, xmx, yms)) {
             return false;
         }
     }
@@ -67,48 +114,73 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
         return false;
     }
 
-    int16_t aa = ((int16_t)sizex) * ((int16_t)sizex);
-    int16_t bb = ((int16_t)sizey) * ((int16_t)sizey);
-    int16_t fa = 4 * ((int16_t)aa);
-    int16_t fb = 4 * ((int16_t)bb);
+    // The decision variables overflow 16 bits for all but the smallest ellipses, so use 32-bit arithmetic
+    int32_t aa = ((int32_t)sizex) * ((int32_t)sizex);
+    int32_t bb = ((int32_t)sizey) * ((int32_t)sizey);
+    int32_t fa = 4 * aa;
+    int32_t fb = 4 * bb;
 
     int16_t dx = 0;
     int16_t dy = ((int16_t)sizey);
 
-    qp_internal_fill_pixdata(device, QP_MAX(sizex, sizey), hue, sat, val);
+    // Filled ellipses are drawn using rects up to the full width of the ellipse and half its height
+    uint32_t span = (QP_MAX(sizex, sizey) * 2) + 1;
+    qp_internal_fill_pixdata(device, filled ? (((uint32_t)sizex * 2) + 1) * (sizey + 1) : span, hue, sat, val);
 
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_ellipse: fail (could not start comms)\n");
         return false;
     }
 
-    bool ret = true;
-    for (int16_t delta = (2 * bb) + (aa * (1 - (2 * sizey))); bb * dx <= aa * dy; dx++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
-            ret = false;
-            break;
-        }
+    // Degenerate ellipses are just lines, and would never terminate below
+    if (sizex == 0 || sizey == 0) {
+        bool ret = qp_internal_fillrect_clipped_impl(device, x - sizex, y - sizey, x + sizex, y + sizey);
+        qp_dprintf("qp_ellipse: %s\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+
+    // First region -- dx increases every step, so points that share the same dy form horizontal runs
+    bool    ret       = true;
+    int16_t run_start = dx;
+    for (int32_t delta = (2 * bb) + (aa * (1 - (2 * sizey))); bb * dx <= aa * dy; dx++) {
         if (delta >= 0) {
+            // dy is about to change, so the current run ends here
+            if (!qp_ellipse_hspan_impl(device, x, y, run_start, dx, dy, filled)) {
+                ret = false;
+                break;
+            }
+            run_start = dx + 1;
             delta += fa * (1 - dy);
             dy--;
         }
         delta += bb * (4 * dx + 6);
     }
+    if (ret && run_start < dx && !qp_ellipse_hspan_impl(device, x, y, run_start, dx - 1, dy, filled)) {
+        ret = false;
+    }
 
     dx = sizex;
     dy = 0;
 
-    for (int16_t delta = (2 * aa) + (bb * (1 - (2 * sizex))); aa * dy <= bb * dx; dy++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
-            ret = false;
-            break;
-        }
+    // Second region -- dy increases every step, so points that share the same dx form vertical runs
+    run_start = dy;
+    for (int32_t delta = (2 * aa) + (bb * (1 - (2 * sizex))); ret && aa * dy <= bb * dx; dy++) {
         if (delta >= 0) {
+            // dx is about to change, so the current run ends here
+            if (!qp_ellipse_vspan_impl(device, x, y, dx, run_start, dy, filled)) {
+                ret = false;
+                break;
+            }
+            run_start = dy + 1;
             delta += fb * (1 - dx);
             dx--;
         }
         delta += aa * (4 * dy + 6);
     }
+    if (ret && run_start < dy && !qp_ellipse_vspan_impl(device, x, y, dx, run_start, dy - 1, filled)) {
+        ret = false;
+    }
 
     qp_dprintf("qp_ellipse: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
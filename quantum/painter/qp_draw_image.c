@@ -16,6 +16,9 @@ typedef struct qgf_image_handle_t {
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
@@ -85,6 +88,30 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the graphics descriptor
+    image->flash_stream = qp_make_flash_stream(address, sizeof(qgf_graphics_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    image->flash_stream.length   = qgf_get_total_size(&image->stream);
+    image->flash_stream.position = 0;
+
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(uint32_t address) {
+    return qp_load_image_internal(image_flash_stream_factory, &address);
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -234,10 +261,16 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
 
     uint16_t l, t, r, b;
     if (frame_info->is_delta) {
+        // Delta frames only cover the region that changed since the previous frame -- coordinates are inclusive
+        if (frame_info->left > frame_info->right || frame_info->top > frame_info->bottom || frame_info->right >= image->width || frame_info->bottom >= image->height) {
+            qp_dprintf("qp_drawimage_recolor: fail (invalid delta region)\n");
+            qp_comms_stop(device);
+            return false;
+        }
         l = x + frame_info->left;
         t = y + frame_info->top;
-        r = x + frame_info->right - 1;
-        b = y + frame_info->bottom - 1;
+        r = x + frame_info->right;
+        b = y + frame_info->bottom;
     } else {
         l = x;
         t = y;
@@ -268,10 +301,10 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, frame_info->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_decode_palette_to_pixdata(device, pixel_count, frame_info->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            ret &= qp_internal_send_pixdata_buffer(device, output_state.pixel_write_pos);
         }
     } else if (frame_info->bpp != driver->native_bits_per_pixel) {
         // Prevent stuff like drawing 24bpp images on 16bpp displays
@@ -286,7 +319,7 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         ret                 = qp_internal_send_bytes(device, byte_count, input_callback, &input_state, qp_internal_byte_appender, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            ret &= qp_internal_send_pixdata_buffer(device, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
         }
     }
 
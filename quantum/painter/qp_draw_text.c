@@ -23,6 +23,9 @@ typedef struct qff_font_handle_t {
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
@@ -35,6 +38,124 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+//
+// Decoded glyphs are kept in the target device's native pixel format, so that redrawing them is a single pixdata call
+// without touching the font's glyph tables or decoder. Entries are packed contiguously in the cache buffer in the
+// order they were inserted; when space is required the least-recently-used entries are evicted and the remaining data
+// compacted.
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+_Static_assert(QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES <= 255, "QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES must be no more than 255");
+
+typedef struct qp_glyph_cache_entry_t {
+    qff_font_handle_t *font;
+    painter_device_t   device;
+    uint32_t           code_point;
+    qp_pixel_t         fg_hsv888;
+    qp_pixel_t         bg_hsv888;
+    uint32_t           offset;
+    uint32_t           length;
+    uint32_t           last_used;
+    uint8_t            width;
+} qp_glyph_cache_entry_t;
+
+__attribute__((__aligned__(4))) static uint8_t qp_glyph_cache_buffer[QUANTUM_PAINTER_GLYPH_CACHE_SIZE];
+static qp_glyph_cache_entry_t                  qp_glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES];
+static uint8_t                                 qp_glyph_cache_count = 0;
+static uint32_t                                qp_glyph_cache_tick  = 0;
+
+static inline uint32_t qp_glyph_cache_used(void) {
+    return qp_glyph_cache_count > 0 ? qp_glyph_cache[qp_glyph_cache_count - 1].offset + qp_glyph_cache[qp_glyph_cache_count - 1].length : 0;
+}
+
+static void qp_glyph_cache_remove(uint8_t index) {
+    uint32_t offset = qp_glyph_cache[index].offset;
+    uint32_t length = qp_glyph_cache[index].length;
+
+    // Shift the pixel data of all subsequent entries down over the removed entry
+    uint32_t trailing = qp_glyph_cache_used() - (offset + length);
+    if (trailing > 0) {
+        memmove(&qp_glyph_cache_buffer[offset], &qp_glyph_cache_buffer[offset + length], trailing);
+    }
+
+    for (uint8_t i = index; i + 1 < qp_glyph_cache_count; ++i) {
+        qp_glyph_cache[i] = qp_glyph_cache[i + 1];
+        qp_glyph_cache[i].offset -= length;
+    }
+    qp_glyph_cache_count--;
+}
+
+// Finds a cached glyph. Fonts with their own palette ignore the requested colors.
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(qff_font_handle_t *qff_font, painter_device_t device, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (uint8_t i = 0; i < qp_glyph_cache_count; ++i) {
+        qp_glyph_cache_entry_t *entry = &qp_glyph_cache[i];
+        if (entry->font == qff_font && entry->code_point == code_point && entry->device == device && (qff_font->has_palette || (memcmp(&entry->fg_hsv888, &fg_hsv888, sizeof(qp_pixel_t)) == 0 && memcmp(&entry->bg_hsv888, &bg_hsv888, sizeof(qp_pixel_t)) == 0))) {
+            entry->last_used = ++qp_glyph_cache_tick;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Reserves space for a glyph, evicting the least-recently-used glyphs if required
+static qp_glyph_cache_entry_t *qp_glyph_cache_insert(qff_font_handle_t *qff_font, painter_device_t device, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint8_t width, uint32_t length) {
+    // Keep each entry 4-byte aligned so that native pixels can be written directly
+    length = (length + 3) & ~3u;
+    if (length > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        return NULL;
+    }
+
+    while (qp_glyph_cache_count == QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES || qp_glyph_cache_used() + length > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        uint8_t lru = 0;
+        for (uint8_t i = 1; i < qp_glyph_cache_count; ++i) {
+            if (qp_glyph_cache[i].last_used < qp_glyph_cache[lru].last_used) {
+                lru = i;
+            }
+        }
+        qp_glyph_cache_remove(lru);
+    }
+
+    qp_glyph_cache_entry_t *entry = &qp_glyph_cache[qp_glyph_cache_count];
+    entry->offset                 = qp_glyph_cache_used();
+    entry->length                 = length;
+    entry->font                   = qff_font;
+    entry->device                 = device;
+    entry->code_point             = code_point;
+    entry->fg_hsv888              = qff_font->has_palette ? (qp_pixel_t){.dummy = 0} : fg_hsv888;
+    entry->bg_hsv888              = qff_font->has_palette ? (qp_pixel_t){.dummy = 0} : bg_hsv888;
+    entry->width                  = width;
+    entry->last_used              = ++qp_glyph_cache_tick;
+    qp_glyph_cache_count++;
+    return entry;
+}
+
+// Drops all cached glyphs belonging to the supplied font
+static void qp_glyph_cache_purge_font(qff_font_handle_t *qff_font) {
+    for (uint8_t i = qp_glyph_cache_count; i > 0; --i) {
+        if (qp_glyph_cache[i - 1].font == qff_font) {
+            qp_glyph_cache_remove(i - 1);
+        }
+    }
+}
+
+// Output state used when decoding a glyph into the cache
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        target;
+    uint32_t         pixel_write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->target, palette, state->pixel_write_pos++, 1, &index);
+}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -72,13 +193,17 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     font->owns_buffer = false;
     font->buffer      = NULL;
 
-    void *ram_buffer = malloc(font->mem_stream.length);
+    // Work out the size of the font, regardless of where the stream is backed
+    uint32_t font_length = qff_get_total_size(&font->stream);
+    qp_stream_setpos(&font->stream, 0);
+
+    void *ram_buffer = malloc(font_length);
     if (ram_buffer == NULL) {
         qp_dprintf("qp_load_font: could not allocate enough RAM for font, falling back to original\n");
     } else {
         do {
             // Copy the data into RAM
-            if (qp_stream_read(ram_buffer, 1, font->mem_stream.length, &font->mem_stream) != font->mem_stream.length) {
+            if (qp_stream_read(ram_buffer, 1, font_length, &font->stream) != font_length) {
                 qp_dprintf("qp_load_font: could not copy from flash to RAM, falling back to original\n");
                 break;
             }
@@ -86,7 +211,7 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
             // Create the new stream with the new buffer
             font->buffer      = ram_buffer;
             font->owns_buffer = true;
-            font->mem_stream  = qp_make_memory_stream(font->buffer, font->mem_stream.length);
+            font->mem_stream  = qp_make_memory_stream(font->buffer, font_length);
         } while (0);
     }
 
@@ -131,6 +256,30 @@ painter_font_handle_t qp_load_font_mem(const void *buffer) {
     return qp_load_font_internal(font_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_flash
+
+static inline bool font_flash_stream_factory(qff_font_handle_t *font, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the font descriptor
+    font->flash_stream = qp_make_flash_stream(address, sizeof(qff_font_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    font->flash_stream.length   = qff_get_total_size(&font->stream);
+    font->flash_stream.position = 0;
+
+    return true;
+}
+
+painter_font_handle_t qp_load_font_flash(uint32_t address) {
+    return qp_load_font_internal(font_flash_stream_factory, &address);
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_font
 
@@ -150,6 +299,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Any cached glyphs are no longer valid
+    qp_glyph_cache_purge_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -160,7 +314,7 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -301,13 +455,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -324,8 +472,28 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
+    uint8_t                            width = 0;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Any cached copy of the glyph knows its width, regardless of the device or colors it was rendered with
+    bool cached = false;
+    for (uint8_t i = 0; i < qp_glyph_cache_count; ++i) {
+        if (qp_glyph_cache[i].font == qff_font && qp_glyph_cache[i].code_point == code_point) {
+            width  = qp_glyph_cache[i].width;
+            cached = true;
+            break;
+        }
+    }
+    if (!cached)
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    {
+        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            qp_dprintf("Failed to prepare glyph for rendering.\n");
+            return false;
+        }
+    }
 
     // Increment the overall width by this glyph's width
     state->width += width;
@@ -344,32 +512,89 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
+    bool                              palette_ready;
 } code_point_iter_drawglyph_state_t;
 
+// Decodes the glyph the font's stream is positioned at, using the palette -- which is only set up the first time it's needed
+static inline bool qp_font_decode_glyph(qff_font_handle_t *qff_font, code_point_iter_drawglyph_state_t *state, uint32_t pixel_count, qp_internal_pixel_output_callback output_callback, void *output_arg) {
+    if (!state->palette_ready) {
+        // Preparing the palette moves the stream, so the position needs to be restored afterwards
+        int32_t  glyph_pos = qp_stream_tell(&qff_font->stream);
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset) || qp_stream_setpos(&qff_font->stream, glyph_pos) < 0) {
+            qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
+            return false;
+        }
+        state->palette_ready = true;
+    }
+
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_drawtext_prepare_glyph_for_render()
+    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+
+    return qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, output_callback, output_arg);
+}
+
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+    uint8_t                            width;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, state->device, code_point, state->fg_hsv888, state->bg_hsv888);
+    if (entry) {
+        // Fast path: the glyph is already in native format, send it straight out
+        width = entry->width;
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
+        state->xpos += width;
+        return width == 0 || driver->driver_vtable->pixdata(state->device, &qp_glyph_cache_buffer[entry->offset], ((uint32_t)width) * height);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
-    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
-
-    // Reset the output state
-    state->output_state->pixel_write_pos = 0;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
 
-    // Configure where we're going to be rendering to
+    // Configure where we're going to be rendering to -- this also waits for any in-flight transfer, so the cache and
+    // pixdata buffers are safe to modify afterwards
     driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
 
     // Move the x-position for the next glyph
     state->xpos += width;
 
-    // Decode the pixel data for the glyph
     uint32_t pixel_count = ((uint32_t)width) * height;
-    bool     ret         = qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, state->output_state);
+    if (pixel_count == 0) {
+        return true;
+    }
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Decode into the cache if the display's pixels are byte-aligned, then send from there
+    if ((driver->native_bits_per_pixel % 8) == 0) {
+        entry = qp_glyph_cache_insert(qff_font, state->device, code_point, state->fg_hsv888, state->bg_hsv888, width, pixel_count * driver->native_bits_per_pixel / 8);
+        if (entry) {
+            qp_glyph_cache_output_state_t cache_state = {.device = state->device, .target = &qp_glyph_cache_buffer[entry->offset], .pixel_write_pos = 0};
+            if (!qp_font_decode_glyph(qff_font, state, pixel_count, qp_glyph_cache_pixel_appender, &cache_state)) {
+                qp_glyph_cache_remove(entry - qp_glyph_cache);
+                return false;
+            }
+            return driver->driver_vtable->pixdata(state->device, cache_state.target, pixel_count);
+        }
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    // Reset the output state
+    state->output_state->pixel_write_pos = 0;
+
+    // Decode the pixel data for the glyph
+    bool ret = qp_font_decode_glyph(qff_font, state, pixel_count, qp_internal_pixel_appender, state->output_state);
 
     // Any leftovers need transmission as well.
     if (ret && state->output_state->pixel_write_pos > 0) {
-        ret &= driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->output_state->pixel_write_pos);
+        ret &= qp_internal_send_pixdata_buffer(state->device, state->output_state->pixel_write_pos);
     }
 
     return ret;
@@ -434,7 +659,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
-    // Set up the codepoint iteration state
+    // Set up the codepoint iteration state -- the palette is prepared when the first glyph needs decoding
     code_point_iter_drawglyph_state_t state = {// Common
                                                .device = device,
                                                .xpos   = x,
@@ -443,16 +668,11 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
-                                               .output_state = &output_state};
-
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
+                                               .output_state = &output_state,
+                                               // Palette
+                                               .fg_hsv888     = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}},
+                                               .bg_hsv888     = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}},
+                                               .palette_ready = false};
 
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
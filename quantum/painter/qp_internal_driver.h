@@ -38,12 +38,17 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef void (*painter_comms_notify_callback)(void *cb_arg);
+typedef bool (*painter_driver_comms_notify_func)(painter_device_t device, painter_comms_notify_callback callback, void *cb_arg);
 
 typedef struct painter_comms_vtable_t {
-    painter_driver_comms_init_func  comms_init;
-    painter_driver_comms_start_func comms_start;
-    painter_driver_comms_stop_func  comms_stop;
-    painter_driver_comms_send_func  comms_send;
+    painter_driver_comms_init_func   comms_init;
+    painter_driver_comms_start_func  comms_start;
+    painter_driver_comms_stop_func   comms_stop;
+    painter_driver_comms_send_func   comms_send;
+    painter_driver_comms_send_func   comms_send_async; // optional, data must remain valid until the next comms operation
+    painter_driver_comms_notify_func comms_notify;     // optional, invokes the callback (possibly from an interrupt) once asynchronous sends complete
+    painter_driver_comms_stop_func   comms_release;    // optional, stops comms without waiting, releasing the bus once asynchronous sends complete
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -119,6 +119,160 @@ qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     return stream;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+#    include "flash_spi.h"
+#    include "qp_comms.h"
+
+static inline bool flash_fill_cache(qp_flash_stream_t *s) {
+    // Read ahead as much as possible, limited by the end of the stream
+    uint16_t length = (uint16_t)QP_MIN((int32_t)sizeof(s->cache), s->length - s->position);
+
+    // Assets are decoded while the display's comms are started, which may be holding the same SPI bus as the flash
+    // chip -- hand the bus over for the duration of the read, then pick up where the display left off
+    painter_device_t device = qp_comms_suspend();
+    flash_status_t   status = flash_read_block(s->address + s->position, s->cache, length);
+    if (!qp_comms_resume(device) || status != FLASH_STATUS_SUCCESS) {
+        s->cache_length = 0;
+        return false;
+    }
+    s->cache_position = s->position;
+    s->cache_length   = length;
+    return true;
+}
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    // Only hit the flash chip if the requested byte isn't already in the read-ahead cache
+    if (s->position < s->cache_position || s->position >= s->cache_position + s->cache_length) {
+        if (!flash_fill_cache(s)) {
+            s->is_eof = true;
+            return STREAM_EOF;
+        }
+    }
+
+    return s->cache[s->position++ - s->cache_position];
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Flash streams are read-only.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    // Same bounds as memory streams -- seeking to the end is fine, past it is not
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    // Update the offset, leaving the cache intact so that short backwards seeks don't need to re-read from flash
+    s->position = position;
+    s->is_eof   = false;
+
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    qp_flash_stream_t stream = {
+        .base           = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .address        = address,
+        .length         = length,
+        .position       = 0,
+        .cache_position = 0,
+        .cache_length   = 0,
+    };
+    return stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash asset packs
+
+typedef struct QP_PACKED qp_asset_pack_header_v1_t {
+    uint32_t magic;       // constant, equal to 0x4B415051 ("QPAK")
+    uint16_t version;     // constant, equal to 0x01
+    uint16_t asset_count; // number of entries in the index which follows
+} qp_asset_pack_header_v1_t;
+
+_Static_assert(sizeof(qp_asset_pack_header_v1_t) == 8, "qp_asset_pack_header_v1_t must be 8 bytes in v1 of the asset pack format");
+
+typedef struct QP_PACKED qp_asset_pack_entry_v1_t {
+    uint32_t offset; // offset of the asset, relative to the start of the pack
+    uint32_t length; // length of the asset, in bytes
+} qp_asset_pack_entry_v1_t;
+
+_Static_assert(sizeof(qp_asset_pack_entry_v1_t) == 8, "qp_asset_pack_entry_v1_t must be 8 bytes in v1 of the asset pack format");
+
+#    define QP_ASSET_PACK_MAGIC 0x4B415051
+
+bool qp_flash_asset_address(uint32_t pack_address, uint16_t index, uint32_t *asset_address) {
+    qp_asset_pack_header_v1_t header;
+    if (flash_read_block(pack_address, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_asset_address: fail (could not read header)\n");
+        return false;
+    }
+
+    if (header.magic != QP_ASSET_PACK_MAGIC || header.version != 0x01) {
+        qp_dprintf("qp_flash_asset_address: fail (invalid asset pack)\n");
+        return false;
+    }
+
+    if (index >= header.asset_count) {
+        qp_dprintf("qp_flash_asset_address: fail (index %d out of range, pack has %d assets)\n", (int)index, (int)header.asset_count);
+        return false;
+    }
+
+    qp_asset_pack_entry_v1_t entry;
+    if (flash_read_block(pack_address + sizeof(header) + index * sizeof(entry), &entry, sizeof(entry)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_asset_address: fail (could not read index)\n");
+        return false;
+    }
+
+    if (asset_address) *asset_address = pack_address + entry.offset;
+    return true;
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
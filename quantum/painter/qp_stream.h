@@ -70,6 +70,26 @@ typedef struct qp_memory_stream_t {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+typedef struct qp_flash_stream_t {
+    qp_stream_t base;
+    uint32_t    address;
+    int32_t     length;
+    int32_t     position;
+    bool        is_eof;
+    int32_t     cache_position;
+    uint16_t    cache_length;
+    uint8_t     cache[QUANTUM_PAINTER_FLASH_READ_AHEAD_SIZE];
+} qp_flash_stream_t;
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length);
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
@@ -1,6 +1,7 @@
 # Quantum Painter Configurables
 QUANTUM_PAINTER_DRIVERS ?=
 QUANTUM_PAINTER_ANIMATIONS_ENABLE ?= yes
+QUANTUM_PAINTER_FLASH_ASSETS_ENABLE ?= no
 
 QUANTUM_PAINTER_LVGL_INTEGRATION ?= no
 
@@ -25,6 +26,7 @@ SRC += \
     $(QUANTUM_DIR)/color.c \
     $(QUANTUM_DIR)/painter/qp.c \
     $(QUANTUM_DIR)/painter/qp_internal.c \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
     $(QUANTUM_DIR)/painter/qp_stream.c \
     $(QUANTUM_DIR)/painter/qgf.c \
     $(QUANTUM_DIR)/painter/qff.c \
@@ -41,6 +43,12 @@ ifeq ($(strip $(QUANTUM_PAINTER_ANIMATIONS_ENABLE)), yes)
     OPT_DEFS += -DQUANTUM_PAINTER_ANIMATIONS_ENABLE
 endif
 
+# Check if people want to load assets from external SPI flash... enable the flash driver if so.
+ifeq ($(strip $(QUANTUM_PAINTER_FLASH_ASSETS_ENABLE)), yes)
+    FLASH_DRIVER := spi
+    OPT_DEFS += -DQUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+endif
+
 # Comms flags
 QUANTUM_PAINTER_NEEDS_COMMS_SPI ?= no
 
@@ -147,7 +155,6 @@ ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI)), yes)
     QUANTUM_LIB_SRC += spi_master.c
     VPATH += $(DRIVER_PATH)/painter/comms
     SRC += \
-        $(QUANTUM_DIR)/painter/qp_comms.c \
         $(DRIVER_PATH)/painter/comms/qp_comms_spi.c
 
     ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET)), yes)
@@ -22,6 +22,7 @@
 #endif
 #ifdef STENO_ENABLE_ALL
 #    include "eeprom.h"
+#    include "eeconfig.h"
 #endif
 
 // All steno keys that have been pressed to form this chord,
@@ -131,13 +132,13 @@ void steno_init(void) {
     if (!eeconfig_is_enabled()) {
         eeconfig_init();
     }
-    mode = eeprom_read_byte(EECONFIG_STENOMODE);
+    mode = eeconfig_read_byte(EECONFIG_STENOMODE);
 }
 
 void steno_set_mode(steno_mode_t new_mode) {
     steno_clear_chord();
     mode = new_mode;
-    eeprom_update_byte(EECONFIG_STENOMODE, mode);
+    eeconfig_update_byte(EECONFIG_STENOMODE, mode);
 }
 #endif // STENO_ENABLE_ALL
 
@@ -36,6 +36,10 @@
 #    include "haptic.h"
 #endif
 
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_CACHE_ENABLE)
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -162,6 +166,9 @@ void shutdown_quantum(void) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_CACHE_ENABLE)
+    eeprom_driver_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -465,6 +472,10 @@ __attribute__((weak)) void shutdown_user(void) {}
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_CACHE_ENABLE)
+    // Commit pending settings, as power may be cut while suspended
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
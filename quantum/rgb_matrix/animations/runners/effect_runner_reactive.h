@@ -12,7 +12,7 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
         RGB_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
         // Reverse search to find most recent key hit
-        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+        for (uint8_t j = g_last_hit_tracker.count; j-- > 0;) {
             if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
                 tick = g_last_hit_tracker.tick[j];
                 break;
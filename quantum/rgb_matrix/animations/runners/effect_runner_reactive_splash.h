@@ -8,16 +8,26 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint8_t count = g_last_hit_tracker.count;
+
+    // the animation time of each hit is the same for every LED, kept static as it can be too large for the stack
+    static uint16_t ticks[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        ticks[j] = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+            uint8_t dist = rgb_matrix_get_led_distance(i, g_last_hit_tracker.index[j]);
+#    else
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+#    endif
+            hsv = effect_func(hsv, dx, dy, dist, ticks[j]);
         }
         hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
         RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
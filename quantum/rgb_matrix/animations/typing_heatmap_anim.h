@@ -16,42 +16,111 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+// Matrix position of each LED, or NO_LED for LEDs which are not bound to a key.
+static uint8_t heatmap_led_row[RGB_MATRIX_LED_COUNT];
+static uint8_t heatmap_led_col[RGB_MATRIX_LED_COUNT];
+// A timer to track the last time we decremented the heatmap values.
+static uint16_t heatmap_decrease_timer;
+// How many steps the heatmap values decrease by during the current frame.
+static uint8_t heatmap_decrease_steps;
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// LEDs bound to a key, ordered by x coordinate, so that a key press only visits
+// those close enough horizontally to be within RGB_MATRIX_TYPING_HEATMAP_SPREAD.
+static uint8_t heatmap_led_by_x[RGB_MATRIX_LED_COUNT];
+static uint8_t heatmap_led_by_x_count;
+#        endif
+static bool heatmap_layout_ready = false;
+
+static void heatmap_init_layout(void) {
+    memset(heatmap_led_row, NO_LED, sizeof heatmap_led_row);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led < RGB_MATRIX_LED_COUNT) {
+                heatmap_led_row[led] = row;
+                heatmap_led_col[led] = col;
+            }
+        }
+    }
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+    // Insertion sort, only done once, as the LED layout does not change
+    heatmap_led_by_x_count = 0;
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        if (heatmap_led_row[led] == NO_LED) continue;
+        uint8_t n = heatmap_led_by_x_count++;
+        while (n > 0 && g_led_config.point[heatmap_led_by_x[n - 1]].x > g_led_config.point[led].x) {
+            heatmap_led_by_x[n] = heatmap_led_by_x[n - 1];
+            n--;
+        }
+        heatmap_led_by_x[n] = led;
+    }
+#        endif
+    heatmap_layout_ready = true;
+}
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
     g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
 #        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
-    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
-        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
-                continue;
-            }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+    // Keys may be pressed before the effect has first been rendered
+    if (!heatmap_layout_ready) {
+        heatmap_init_layout();
+    }
+    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+
+    // Find the first LED which could be within range horizontally
+    int16_t x  = g_led_config.point[led].x;
+    int16_t y  = g_led_config.point[led].y;
+    uint8_t lo = 0;
+    uint8_t hi = heatmap_led_by_x_count;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (g_led_config.point[heatmap_led_by_x[mid]].x < x - RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (uint8_t n = lo; n < heatmap_led_by_x_count; n++) {
+        uint8_t other = heatmap_led_by_x[n];
+        if (g_led_config.point[other].x > x + RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+            break;
+        }
+        int16_t dy = g_led_config.point[other].y - y;
+        if (other == led || dy > RGB_MATRIX_TYPING_HEATMAP_SPREAD || dy < -RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+            continue;
+        }
+#            ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+        uint8_t distance = rgb_matrix_get_led_distance(led, other);
+#            else
+        int16_t dx       = g_led_config.point[other].x - x;
+        uint8_t distance = sqrt16(dx * dx + dy * dy);
+#            endif
+        if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+            uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+            if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
             }
+            uint8_t i_row                    = heatmap_led_row[other];
+            uint8_t i_col                    = heatmap_led_col[other];
+            g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
         }
     }
 #        endif
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
+static void heatmap_init(void) {
+    heatmap_init_layout();
+    heatmap_decrease_timer = timer_read();
+}
 
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
@@ -59,38 +128,42 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_init();
     }
 
     // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
+    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to work out how
+    // much to decrease the heatmap by when the animation starts. The decrease
+    // is derived from the elapsed time, so slow frames do not slow it down.
     if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
+        uint16_t elapsed = timer_elapsed(heatmap_decrease_timer);
+        if (elapsed >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS * UINT8_MAX) {
+            heatmap_decrease_steps = UINT8_MAX;
             heatmap_decrease_timer = timer_read();
+        } else {
+            heatmap_decrease_steps = elapsed / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+            heatmap_decrease_timer += heatmap_decrease_steps * RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
         }
     }
 
-    // Render heatmap & decrease
-    uint8_t count = 0;
-    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
-            if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
-                count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
-                if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
-
-                HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-                RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-                rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
-            }
-        }
+    // Decrease & render heatmap
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        uint8_t row = heatmap_led_row[i];
+        if (row == NO_LED) continue;
+        uint8_t col = heatmap_led_col[i];
+
+        uint8_t val = g_rgb_frame_buffer[row][col];
+#        ifdef RGB_MATRIX_DOUBLE_BUFFER
+        // Cold keys are black and stay drawn in the effect layer
+        if (!val) continue;
+#        endif
+        val                          = qsub8(val, heatmap_decrease_steps);
+        g_rgb_frame_buffer[row][col] = val;
+
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
 
     return rgb_matrix_check_finished_leds(led_max);
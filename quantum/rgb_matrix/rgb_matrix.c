@@ -128,8 +128,83 @@ static uint32_t rgb_anykey_timer;
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+// age sorted ring of key hits, oldest at head
+static struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t timer[LED_HITS_TO_REMEMBER];
+} last_hit_buffer;
+
+static inline uint8_t last_hit_slot(uint8_t offset) {
+    uint16_t slot = last_hit_buffer.head + offset;
+    return slot >= LED_HITS_TO_REMEMBER ? slot - LED_HITS_TO_REMEMBER : slot;
+}
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+// distance between every pair of LEDs, stored as a lower triangular matrix
+static uint8_t led_distance_cache[RGB_MATRIX_LED_COUNT * (RGB_MATRIX_LED_COUNT - 1) / 2];
+#endif // RGB_MATRIX_SPLASH_DISTANCE_CACHE
+
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+// frame composition buffers, only the composited result is sent to the driver
+static RGB                rgb_frame_layers[RGB_MATRIX_LAYER_COUNT][RGB_MATRIX_LED_COUNT];
+static uint8_t            rgb_frame_alpha[RGB_MATRIX_LAYER_COUNT - 1][RGB_MATRIX_LED_COUNT];
+static RGB                rgb_frame_flushed[RGB_MATRIX_LED_COUNT];
+static rgb_matrix_layer_t rgb_frame_active_layer = RGB_MATRIX_LAYER_EFFECT;
+static bool               rgb_frame_invalidated  = true;
+#endif // RGB_MATRIX_DOUBLE_BUFFER
+
+#if defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
+// FNV-1a hash of every colour written since the last flush
+#    define RGB_FRAME_HASH_BASIS 0x811C9DC5UL
+static uint32_t rgb_frame_hash         = RGB_FRAME_HASH_BASIS;
+static uint32_t rgb_frame_hash_flushed = 0;
+
+static inline void rgb_frame_hash_byte(uint8_t data) {
+    rgb_frame_hash = (rgb_frame_hash ^ data) * 0x01000193UL;
+}
+
+static void rgb_frame_hash_color(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_frame_hash_byte(index);
+    rgb_frame_hash_byte(red);
+    rgb_frame_hash_byte(green);
+    rgb_frame_hash_byte(blue);
+}
+
+// what static effects and indicators are rendered from, so the task can idle until any of it changes
+typedef struct {
+    rgb_config_t  config;
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+    led_t         led_state;
+} rgb_idle_state_t;
+
+static rgb_idle_state_t rgb_idle_state;
+static bool             rgb_frame_unchanged = false;
+static bool             rgb_idle_wake       = false;
+
+static void rgb_idle_state_read(rgb_idle_state_t *state) {
+    memset(state, 0, sizeof(rgb_idle_state_t));
+    state->config              = rgb_matrix_config;
+    state->layer_state         = layer_state;
+    state->default_layer_state = default_layer_state;
+    state->led_state           = host_keyboard_led_state();
+}
+
+static bool rgb_task_idle(uint8_t effect) {
+    // only effects whose output never changes on its own can idle
+    if (effect != rgb_last_effect || rgb_idle_wake || !rgb_frame_unchanged || !(effect == RGB_MATRIX_NONE || effect == RGB_MATRIX_SOLID_COLOR)) {
+        return false;
+    }
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_IDLE_REFRESH_INTERVAL) {
+        return false;
+    }
+    rgb_idle_state_t state;
+    rgb_idle_state_read(&state);
+    return memcmp(&state, &rgb_idle_state, sizeof(rgb_idle_state_t)) == 0;
+}
+#endif // defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
 
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
@@ -187,19 +262,100 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+void rgb_matrix_set_layer_color(rgb_matrix_layer_t layer, int index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) {
+    if (layer >= RGB_MATRIX_LAYER_COUNT || index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+
+    rgb_frame_layers[layer][index].r = red;
+    rgb_frame_layers[layer][index].g = green;
+    rgb_frame_layers[layer][index].b = blue;
+    if (layer != RGB_MATRIX_LAYER_EFFECT) {
+        rgb_frame_alpha[layer - 1][index] = alpha;
+    }
+}
+
+void rgb_matrix_clear_layer(rgb_matrix_layer_t layer) {
+    if (layer >= RGB_MATRIX_LAYER_COUNT) return;
+
+    if (layer == RGB_MATRIX_LAYER_EFFECT) {
+        memset(rgb_frame_layers[layer], 0, sizeof(rgb_frame_layers[layer]));
+    } else {
+        memset(rgb_frame_alpha[layer - 1], 0, sizeof(rgb_frame_alpha[layer - 1]));
+    }
+}
+
+static void rgb_frame_flush(bool overlays) {
+    bool dirty = rgb_frame_invalidated;
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        RGB color = rgb_frame_layers[RGB_MATRIX_LAYER_EFFECT][i];
+        if (overlays) {
+            for (uint8_t layer = RGB_MATRIX_LAYER_EFFECT + 1; layer < RGB_MATRIX_LAYER_COUNT; layer++) {
+                uint8_t alpha = rgb_frame_alpha[layer - 1][i];
+                if (alpha == UINT8_MAX) {
+                    color = rgb_frame_layers[layer][i];
+                } else if (alpha) {
+                    color.r = blend8(color.r, rgb_frame_layers[layer][i].r, alpha);
+                    color.g = blend8(color.g, rgb_frame_layers[layer][i].g, alpha);
+                    color.b = blend8(color.b, rgb_frame_layers[layer][i].b, alpha);
+                }
+            }
+        }
+
+        // only hand over LEDs which actually changed since the last flush
+        if (rgb_frame_invalidated || memcmp(&color, &rgb_frame_flushed[i], sizeof(RGB)) != 0) {
+            rgb_frame_flushed[i] = color;
+            rgb_matrix_driver.set_color(i, color.r, color.g, color.b);
+            dirty = true;
+        }
+    }
+
+    rgb_frame_invalidated = false;
+    if (dirty) {
+        rgb_matrix_driver.flush();
+    }
+}
+#endif // RGB_MATRIX_DOUBLE_BUFFER
+
+#ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+uint8_t rgb_matrix_get_led_distance(uint8_t led_a, uint8_t led_b) {
+    if (led_a == led_b) return 0;
+    if (led_a < led_b) {
+        uint8_t tmp = led_a;
+        led_a       = led_b;
+        led_b       = tmp;
+    }
+    return led_distance_cache[(uint16_t)led_a * (led_a - 1) / 2 + led_b];
+}
+#endif // RGB_MATRIX_SPLASH_DISTANCE_CACHE
+
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+    rgb_frame_flush(true);
+#else
     rgb_matrix_driver.flush();
+#endif
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+    rgb_matrix_set_layer_color(rgb_frame_active_layer, index, red, green, blue, UINT8_MAX);
+#else
+#    ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_color(index, red, green, blue);
+#    endif
     rgb_matrix_driver.set_color(index, red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_DOUBLE_BUFFER) || (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT))
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+    rgb_frame_hash_color(NO_LED, red, green, blue);
+#    endif
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
@@ -211,6 +367,10 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #if RGB_MATRIX_TIMEOUT > 0
     rgb_anykey_timer = 0;
 #endif // RGB_MATRIX_TIMEOUT > 0
+#if defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
+    // indicators may depend on state that changes with key presses
+    rgb_idle_wake = true;
+#endif // defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     uint8_t led[LED_HITS_TO_REMEMBER];
@@ -225,21 +385,19 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    uint32_t now = sync_timer_read32();
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        uint8_t slot;
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            slot = last_hit_slot(last_hit_buffer.count);
+            last_hit_buffer.count++;
+        } else {
+            // overwrite the oldest hit
+            slot                 = last_hit_buffer.head;
+            last_hit_buffer.head = last_hit_slot(1);
+        }
+        last_hit_buffer.index[slot] = led[i];
+        last_hit_buffer.timer[slot] = now;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -291,9 +449,9 @@ static bool rgb_matrix_none(effect_params_t *params) {
 }
 
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#if RGB_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#endif // RGB_MATRIX_TIMEOUT > 0
     rgb_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -302,22 +460,13 @@ static void rgb_task_timers(void) {
         rgb_anykey_timer += deltaTime;
     }
 #endif // RGB_MATRIX_TIMEOUT > 0
-
-    // Update double buffer last hit timers
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void rgb_task_sync(void) {
+static void rgb_task_sync(uint8_t effect) {
     eeconfig_flush_rgb_matrix(false);
+#if defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
+    if (rgb_task_idle(effect)) return;
+#endif // defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
     // next task
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
@@ -328,9 +477,31 @@ static void rgb_task_start(void) {
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
+#if defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
+    rgb_idle_state_read(&rgb_idle_state);
+    rgb_idle_wake = false;
+#endif // defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    // drop hits which are too old to be tracked
+    while (last_hit_buffer.count && (g_rgb_timer - last_hit_buffer.timer[last_hit_buffer.head]) >= UINT16_MAX) {
+        last_hit_buffer.head = last_hit_slot(1);
+        last_hit_buffer.count--;
+    }
+
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        uint8_t slot                = last_hit_slot(i);
+        uint8_t led                 = last_hit_buffer.index[slot];
+        g_last_hit_tracker.x[i]     = g_led_config.point[led].x;
+        g_last_hit_tracker.y[i]     = g_led_config.point[led].y;
+        g_last_hit_tracker.index[i] = led;
+        g_last_hit_tracker.tick[i]  = g_rgb_timer - last_hit_buffer.timer[slot];
+    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+    // indicators are redrawn from scratch every frame
+    rgb_matrix_clear_layer(RGB_MATRIX_LAYER_INDICATOR);
+#endif // RGB_MATRIX_DOUBLE_BUFFER
 
     // next task
     rgb_task_state = RENDERING;
@@ -397,12 +568,29 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+#if defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
+    // skip the driver flush if the same colours were written as last frame
+    bool changed = (rgb_frame_hash != rgb_frame_hash_flushed) || (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+    rgb_frame_hash_flushed = rgb_frame_hash;
+    rgb_frame_hash         = RGB_FRAME_HASH_BASIS;
+    rgb_frame_unchanged    = !changed;
+#endif // defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && !defined(RGB_MATRIX_DOUBLE_BUFFER)
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#if defined(RGB_MATRIX_DOUBLE_BUFFER)
+    // overlays are only shown while an effect is running
+    rgb_frame_flush(effect != 0);
+#elif defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES)
+    if (changed) {
+        rgb_matrix_update_pwm_buffers();
+    }
+#else
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -428,15 +616,21 @@ void rgb_matrix_task(void) {
         case RENDERING:
             rgb_task_render(effect);
             if (effect) {
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+                rgb_frame_active_layer = RGB_MATRIX_LAYER_INDICATOR;
+#endif
                 rgb_matrix_indicators();
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+                rgb_frame_active_layer = RGB_MATRIX_LAYER_EFFECT;
+#endif
             }
             break;
         case FLUSHING:
             rgb_task_flush(effect);
             break;
         case SYNCING:
-            rgb_task_sync();
+            rgb_task_sync(effect);
             break;
     }
 }
@@ -480,11 +674,18 @@ void rgb_matrix_init(void) {
         g_last_hit_tracker.tick[i] = UINT16_MAX;
     }
 
+    last_hit_buffer.head  = 0;
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+    for (uint8_t b = 1; b < RGB_MATRIX_LED_COUNT; b++) {
+        for (uint8_t a = 0; a < b; a++) {
+            int16_t dx                                        = g_led_config.point[b].x - g_led_config.point[a].x;
+            int16_t dy                                        = g_led_config.point[b].y - g_led_config.point[a].y;
+            led_distance_cache[(uint16_t)b * (b - 1) / 2 + a] = sqrt16(dx * dx + dy * dy);
+        }
+    }
+#endif // RGB_MATRIX_SPLASH_DISTANCE_CACHE
 
     if (!eeconfig_is_enabled()) {
         dprintf("rgb_matrix_init_drivers eeconfig is not enabled.\n");
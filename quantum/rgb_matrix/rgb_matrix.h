@@ -48,6 +48,10 @@
 #    define RGB_MATRIX_LED_FLUSH_LIMIT 16
 #endif
 
+#ifndef RGB_MATRIX_IDLE_REFRESH_INTERVAL
+#    define RGB_MATRIX_IDLE_REFRESH_INTERVAL 1000
+#endif
+
 #ifndef RGB_MATRIX_LED_PROCESS_LIMIT
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (RGB_MATRIX_LED_COUNT + 4) / 5
 #endif
@@ -123,9 +127,18 @@ void eeconfig_update_rgb_matrix(void);
 uint8_t rgb_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i);
 uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
 
+#ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+uint8_t rgb_matrix_get_led_distance(uint8_t led_a, uint8_t led_b);
+#endif
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+void rgb_matrix_set_layer_color(rgb_matrix_layer_t layer, int index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha);
+void rgb_matrix_clear_layer(rgb_matrix_layer_t layer);
+#endif
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
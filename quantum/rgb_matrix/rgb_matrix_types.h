@@ -38,6 +38,9 @@
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
 #endif // LED_HITS_TO_REMEMBER
+#if LED_HITS_TO_REMEMBER > 255
+#    error "LED_HITS_TO_REMEMBER must not be greater than 255"
+#endif
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 typedef struct PACKED {
@@ -51,6 +54,16 @@ typedef struct PACKED {
 
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+// Layers composited, bottom to top, into the frame sent to the driver
+typedef enum rgb_matrix_layer_t {
+    RGB_MATRIX_LAYER_EFFECT,    // Written by effects, always opaque
+    RGB_MATRIX_LAYER_REACTIVE,  // Persistent overlay, cleared manually
+    RGB_MATRIX_LAYER_INDICATOR, // Written by indicator callbacks, cleared every frame
+    RGB_MATRIX_LAYER_COUNT
+} rgb_matrix_layer_t;
+#endif // RGB_MATRIX_DOUBLE_BUFFER
+
 typedef uint8_t led_flags_t;
 
 typedef struct PACKED {
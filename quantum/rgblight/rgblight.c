@@ -26,6 +26,7 @@
 #include <lib/lib8tion/lib8tion.h>
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
+#    include "eeconfig.h"
 #endif
 #ifdef VELOCIKEY_ENABLE
 #    include "velocikey.h"
@@ -179,7 +180,7 @@ void rgblight_check_config(void) {
 
 uint64_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
-    return (uint64_t)((eeprom_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
+    return (uint64_t)((eeconfig_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeconfig_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
 #else
     return 0;
 #endif
@@ -188,8 +189,8 @@ uint64_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint64_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
 #endif
 }
 
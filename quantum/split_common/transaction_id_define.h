@@ -74,6 +74,11 @@ enum serial_transaction_id {
     PUT_OLED,
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+    PUT_OLED_FRAMEBUFFER,
+    GET_OLED_FRAMEBUFFER_ACK,
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
     PUT_ST7565,
 #endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
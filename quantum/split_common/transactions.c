@@ -599,6 +599,177 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
+////////////////////////////////////////////////////
+// OLED framebuffer
+
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+
+#    define OLED_FRAMEBUFFER_END_MARKER 0xFF
+#    define OLED_FRAMEBUFFER_RUN_FLAG 0x80
+#    define OLED_FRAMEBUFFER_MAX_COUNT 128
+
+_Static_assert(OLED_BLOCK_COUNT < OLED_FRAMEBUFFER_END_MARKER, "OLED_BLOCK_COUNT too large for split OLED framebuffer sync");
+_Static_assert(SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE >= 1 + OLED_BLOCK_SIZE + (OLED_BLOCK_SIZE + OLED_FRAMEBUFFER_MAX_COUNT - 1) / OLED_FRAMEBUFFER_MAX_COUNT, "SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE too small to hold an uncompressible OLED block");
+_Static_assert(sizeof(split_oled_framebuffer_sync_t) <= 255, "SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE too large for a single transaction");
+
+// Run-length encodes a block of the framebuffer. Each chunk starts with a control byte: if the top bit is set, the
+// following byte is repeated (control & 0x7F) + 1 times, otherwise (control + 1) literal bytes follow. Returns the
+// number of bytes written, or 0 if the encoded block doesn't fit.
+static uint8_t oled_framebuffer_encode(const uint8_t *src, uint16_t length, uint8_t *dest, uint8_t dest_size) {
+    uint8_t  written = 0;
+    uint16_t pos     = 0;
+    while (pos < length) {
+        uint16_t run = 1;
+        while (pos + run < length && run < OLED_FRAMEBUFFER_MAX_COUNT && src[pos + run] == src[pos]) {
+            ++run;
+        }
+
+        if (run >= 3) {
+            if (written + 2 > dest_size) return 0;
+            dest[written++] = OLED_FRAMEBUFFER_RUN_FLAG | (run - 1);
+            dest[written++] = src[pos];
+            pos += run;
+        } else {
+            // Gather literals up until the next run worth encoding
+            uint16_t count = 0;
+            while (pos + count < length && count < OLED_FRAMEBUFFER_MAX_COUNT) {
+                if (pos + count + 2 < length && src[pos + count] == src[pos + count + 1] && src[pos + count] == src[pos + count + 2]) break;
+                ++count;
+            }
+            if (written + 1 + count > dest_size) return 0;
+            dest[written++] = count - 1;
+            memcpy(&dest[written], &src[pos], count);
+            written += count;
+            pos += count;
+        }
+    }
+    return written;
+}
+
+static bool oled_framebuffer_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t        last_update  = 0;
+    static uint8_t         sequence     = 0;
+    static uint8_t         resync_block = 0;
+    static OLED_BLOCK_TYPE in_flight    = 0;
+    static bool            synced       = false;
+
+    // The slave may have outlived a previous master session, so carry on from the last sequence number it applied --
+    // starting over could repeat it, which the slave would drop as already seen
+    if (!synced) {
+        if (!transport_read(GET_OLED_FRAMEBUFFER_ACK, &sequence, sizeof(sequence))) {
+            return false;
+        }
+        synced = true;
+    }
+
+    // The slave only sees the most recent packet, so the previous one has to be acknowledged before sending another
+    if (in_flight) {
+        uint8_t applied;
+        if (!transport_read(GET_OLED_FRAMEBUFFER_ACK, &applied, sizeof(applied))) {
+            return false;
+        }
+        if (applied != sequence) {
+            if (timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+                return true;
+            }
+            // Lost or rejected by the slave, so its blocks need sending again
+            oled_slave_dirty |= in_flight;
+        }
+        in_flight = 0;
+    }
+
+    OLED_BLOCK_TYPE pending = oled_slave_dirty;
+    if (!pending) {
+        if (timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+            return true;
+        }
+        // Periodically resend a block even if nothing changed, so that a slave which was reset catches up
+        pending      = (OLED_BLOCK_TYPE)1 << resync_block;
+        resync_block = (resync_block + 1) % OLED_BLOCK_COUNT;
+    }
+
+    // Pack as many dirty blocks as will fit into the packet
+    split_oled_framebuffer_sync_t packet;
+    OLED_BLOCK_TYPE               sent   = 0;
+    uint8_t                       length = 0;
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT && length + 1 < sizeof(packet.data); ++i) {
+        if (!(pending & ((OLED_BLOCK_TYPE)1 << i))) continue;
+        uint8_t encoded = oled_framebuffer_encode(&oled_slave_buffer[OLED_BLOCK_SIZE * i], OLED_BLOCK_SIZE, &packet.data[length + 1], sizeof(packet.data) - length - 1);
+        if (!encoded) break;
+        packet.data[length] = i;
+        length += 1 + encoded;
+        sent |= (OLED_BLOCK_TYPE)1 << i;
+    }
+    memset(&packet.data[length], OLED_FRAMEBUFFER_END_MARKER, sizeof(packet.data) - length);
+    // Zero is skipped, as that is what a freshly reset slave has last seen
+    if (++sequence == 0) {
+        sequence = 1;
+    }
+    packet.sequence = sequence;
+    packet.checksum = crc8(&packet.sequence, sizeof(packet) - offsetof(split_oled_framebuffer_sync_t, sequence));
+
+    if (!transport_write(PUT_OLED_FRAMEBUFFER, &packet, sizeof(packet))) {
+        return false;
+    }
+    oled_slave_dirty &= ~sent;
+    in_flight   = sent;
+    last_update = timer_read32();
+    return true;
+}
+
+static void oled_framebuffer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t                last_sequence = 0;
+    split_oled_framebuffer_sync_t packet;
+
+    split_shared_memory_lock();
+    memcpy(&packet, &split_shmem->oled_framebuffer, sizeof(packet));
+    split_shared_memory_unlock();
+
+    if (packet.sequence == last_sequence || packet.checksum != crc8(&packet.sequence, sizeof(packet) - offsetof(split_oled_framebuffer_sync_t, sequence))) {
+        return;
+    }
+    last_sequence = packet.sequence;
+
+    // The packet has been copied out of shared memory, so the master is free to send the next one
+    split_shared_memory_lock();
+    split_shmem->oled_framebuffer_ack = packet.sequence;
+    split_shared_memory_unlock();
+
+    // Blit the received blocks; only bytes that differ mark the local framebuffer as dirty
+    uint8_t pos = 0;
+    while (pos < sizeof(packet.data) && packet.data[pos] < OLED_BLOCK_COUNT) {
+        uint16_t index = OLED_BLOCK_SIZE * packet.data[pos++];
+        uint16_t end   = index + OLED_BLOCK_SIZE;
+        while (index < end && pos < sizeof(packet.data)) {
+            uint8_t control = packet.data[pos++];
+            uint8_t count   = (control & ~OLED_FRAMEBUFFER_RUN_FLAG) + 1;
+            if (control & OLED_FRAMEBUFFER_RUN_FLAG) {
+                if (pos >= sizeof(packet.data)) return;
+                uint8_t value = packet.data[pos++];
+                while (count-- && index < end) {
+                    oled_write_raw_byte(value, index++);
+                }
+            } else {
+                while (count-- && index < end && pos < sizeof(packet.data)) {
+                    oled_write_raw_byte(packet.data[pos++], index++);
+                }
+            }
+        }
+    }
+}
+
+#    define TRANSACTIONS_OLED_FRAMEBUFFER_MASTER() TRANSACTION_HANDLER_MASTER(oled_framebuffer)
+#    define TRANSACTIONS_OLED_FRAMEBUFFER_SLAVE() TRANSACTION_HANDLER_SLAVE(oled_framebuffer)
+#    define TRANSACTIONS_OLED_FRAMEBUFFER_REGISTRATIONS [PUT_OLED_FRAMEBUFFER] = trans_initiator2target_initializer(oled_framebuffer), [GET_OLED_FRAMEBUFFER_ACK] = trans_target2initiator_initializer(oled_framebuffer_ack),
+
+#else // defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+
+#    define TRANSACTIONS_OLED_FRAMEBUFFER_MASTER()
+#    define TRANSACTIONS_OLED_FRAMEBUFFER_SLAVE()
+#    define TRANSACTIONS_OLED_FRAMEBUFFER_REGISTRATIONS
+
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+
 ////////////////////////////////////////////////////
 // ST7565
 
@@ -871,6 +1042,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
+    TRANSACTIONS_OLED_FRAMEBUFFER_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
     TRANSACTIONS_POINTING_REGISTRATIONS
     TRANSACTIONS_WATCHDOG_REGISTRATIONS
@@ -901,6 +1073,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_RGB_MATRIX_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_OLED_FRAMEBUFFER_MASTER();
     TRANSACTIONS_ST7565_MASTER();
     TRANSACTIONS_POINTING_MASTER();
     TRANSACTIONS_WATCHDOG_MASTER();
@@ -924,6 +1097,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGB_MATRIX_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
+    TRANSACTIONS_OLED_FRAMEBUFFER_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
     TRANSACTIONS_POINTING_SLAVE();
     TRANSACTIONS_WATCHDOG_SLAVE();
@@ -105,6 +105,18 @@ typedef struct _split_mods_sync_t {
 } split_mods_sync_t;
 #endif // SPLIT_MODS_ENABLE
 
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+#    include "oled_driver.h"
+#    ifndef SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE
+#        define SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE (OLED_BLOCK_SIZE + 2)
+#    endif // SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE
+typedef struct _split_oled_framebuffer_sync_t {
+    uint8_t checksum;
+    uint8_t sequence;
+    uint8_t data[SPLIT_OLED_FRAMEBUFFER_PAYLOAD_SIZE]; // run-length encoded blocks, each prefixed with its block index
+} split_oled_framebuffer_sync_t;
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 #    include "pointing_device.h"
 typedef struct _split_slave_pointing_sync_t {
@@ -201,6 +213,11 @@ typedef struct _split_shared_memory_t {
     uint8_t current_oled_state;
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+    split_oled_framebuffer_sync_t oled_framebuffer;
+    uint8_t                       oled_framebuffer_ack; // sequence number of the last packet applied by the slave
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_FRAMEBUFFER_ENABLE)
+
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
     uint8_t current_st7565_state;
 #endif // ST7565_ENABLE(OLED_ENABLE) && defined(SPLIT_ST7565_ENABLE)
@@ -142,7 +142,7 @@ static void unicode_play_song(uint8_t mode) {
 #endif
 
 void unicode_input_mode_init(void) {
-    unicode_config.raw = eeprom_read_byte(EECONFIG_UNICODEMODE);
+    unicode_config.raw = eeconfig_read_byte(EECONFIG_UNICODEMODE);
 #if UNICODE_SELECTED_MODES != -1
 #    if UNICODE_CYCLE_PERSIST
     // Find input_mode in selected modes
@@ -199,7 +199,7 @@ void cycle_unicode_input_mode(int8_t offset) {
 }
 
 void persist_unicode_input_mode(void) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
 __attribute__((weak)) void unicode_input_start(void) {
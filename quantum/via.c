@@ -243,6 +243,99 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+// Streamed keymap transfers move a whole range of the keymap buffer with a single request, instead of one request and
+// response per 28 bytes. Each report in the stream is [ command_id, sequence_hi, sequence_lo, data... ].
+#define VIA_STREAM_HEADER_SIZE 3
+// Largest raw HID report that can be streamed, which matches the report size on every supported platform
+#define VIA_STREAM_REPORT_SIZE 32
+
+static struct {
+    uint16_t offset;
+    uint16_t remaining;
+    uint16_t sequence;
+} via_stream_write;
+
+// Reads are sent from via_task(), one report per call, so that matrix scanning continues while the host drains them
+static struct {
+    uint16_t offset;
+    uint16_t remaining;
+    uint16_t sequence;
+    uint8_t  length;
+    uint8_t  report[VIA_STREAM_REPORT_SIZE];
+} via_stream_read;
+
+// Limits a requested range to the keymap buffer, returning the number of bytes within it
+static uint16_t via_dynamic_keymap_stream_clamp(uint16_t offset, uint16_t size) {
+    uint16_t keymap_size = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    if (offset >= keymap_size) {
+        return 0;
+    }
+    return MIN(size, keymap_size - offset);
+}
+
+static void via_dynamic_keymap_get_buffer_stream(uint8_t *data, uint8_t length) {
+    // data = [ command_id, offset_hi, offset_lo, size_hi, size_lo ]
+    uint16_t offset    = (data[1] << 8) | data[2];
+    uint16_t remaining = via_dynamic_keymap_stream_clamp(offset, (data[3] << 8) | data[4]);
+
+    if (remaining == 0 || length > sizeof(via_stream_read.report)) {
+        via_stream_read.remaining = 0;
+        raw_hid_send(data, length);
+        return;
+    }
+    // Any stream already in progress is abandoned
+    via_stream_read.offset    = offset;
+    via_stream_read.remaining = remaining;
+    via_stream_read.sequence  = 0;
+    via_stream_read.length    = length;
+    via_stream_read.report[0] = data[0];
+}
+
+void via_task(void) {
+    if (via_stream_read.remaining == 0) {
+        return;
+    }
+
+    uint8_t *data  = via_stream_read.report;
+    uint8_t  chunk = via_stream_read.length - VIA_STREAM_HEADER_SIZE;
+    uint8_t  size  = MIN(via_stream_read.remaining, chunk);
+    data[1]        = via_stream_read.sequence >> 8;
+    data[2]        = via_stream_read.sequence & 0xFF;
+    dynamic_keymap_get_buffer(via_stream_read.offset, size, &data[VIA_STREAM_HEADER_SIZE]);
+    memset(&data[VIA_STREAM_HEADER_SIZE + size], 0, chunk - size);
+    raw_hid_send(data, via_stream_read.length);
+
+    via_stream_read.offset += size;
+    via_stream_read.remaining -= size;
+    via_stream_read.sequence++;
+}
+
+static void via_dynamic_keymap_set_buffer_stream(uint8_t *data, uint8_t length) {
+    // data = [ command_id, offset_hi, offset_lo, size_hi, size_lo ]
+    via_stream_write.offset    = (data[1] << 8) | data[2];
+    via_stream_write.remaining = via_dynamic_keymap_stream_clamp(via_stream_write.offset, (data[3] << 8) | data[4]);
+    via_stream_write.sequence  = 0;
+}
+
+// Returns true if a response should be sent, which is only done for the final report of the stream, or on error
+static bool via_dynamic_keymap_stream_data(uint8_t *data, uint8_t length) {
+    // data = [ command_id, sequence_hi, sequence_lo, data... ]
+    uint16_t sequence = (data[1] << 8) | data[2];
+    if (via_stream_write.remaining == 0 || sequence != via_stream_write.sequence) {
+        // Nothing expected, or a report was lost -- abort, and let the host restart the transfer
+        via_stream_write.remaining = 0;
+        data[0]                    = id_unhandled;
+        return true;
+    }
+
+    uint8_t size = MIN(via_stream_write.remaining, length - VIA_STREAM_HEADER_SIZE);
+    dynamic_keymap_set_buffer(via_stream_write.offset, size, &data[VIA_STREAM_HEADER_SIZE]);
+    via_stream_write.offset += size;
+    via_stream_write.remaining -= size;
+    via_stream_write.sequence++;
+    return via_stream_write.remaining == 0;
+}
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -403,6 +496,21 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+        case id_dynamic_keymap_get_buffer_stream: {
+            // Sends its own stream of responses from via_task()
+            via_dynamic_keymap_get_buffer_stream(data, length);
+            return;
+        }
+        case id_dynamic_keymap_set_buffer_stream: {
+            via_dynamic_keymap_set_buffer_stream(data, length);
+            break;
+        }
+        case id_dynamic_keymap_stream_data: {
+            if (!via_dynamic_keymap_stream_data(data, length)) {
+                return;
+            }
+            break;
+        }
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
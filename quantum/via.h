@@ -92,6 +92,9 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_get_buffer_stream     = 0x16,
+    id_dynamic_keymap_set_buffer_stream     = 0x17,
+    id_dynamic_keymap_stream_data           = 0x18,
     id_unhandled                            = 0xFF,
 };
 
@@ -147,6 +150,9 @@ void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 void via_init(void);
 
+// Called by QMK core to send any pending streamed keymap reads.
+void via_task(void);
+
 // Used by VIA to store and retrieve the layout options.
 uint32_t via_get_layout_options(void);
 void     via_set_layout_options(uint32_t value);
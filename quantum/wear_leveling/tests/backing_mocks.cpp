@@ -17,12 +17,17 @@ void MockBackingStore::reset_instance() {
     backing_erasure_count     = 0;
     backing_max_write_count   = 0;
     backing_total_write_count = 0;
+    backing_elapsed_us        = 0;
+    backing_busy_polls        = 0;
+    backing_busy_fails        = false;
+    sector_erases.fill(0);
 
     backing_init_invoke_count   = 0;
     backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_erase_invoke_count        = 0;
+    backing_erase_sector_invoke_count = 0;
+    backing_write_invoke_count        = 0;
+    backing_lock_invoke_count         = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -71,10 +76,37 @@ bool MockBackingStore::erase(void) {
     // Keep track of the erase in the write log so that we can verify during tests
     append_log(true);
 
+    for (auto&& e : sector_erases)
+        ++e;
+    backing_elapsed_us += BACKING_STORE_SECTOR_COUNT::value * MOCK_BACKING_STORE_ERASE_TIME_US;
+
     ++backing_erasure_count;
     return true;
 }
 
+bool MockBackingStore::erase_sector(uint32_t address, uint32_t& next_address) {
+    ++backing_erase_sector_invoke_count;
+
+    EXPECT_TRUE(address < WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // Drop out of erase early with failure if we need to
+    if (erase_success_callback && !erase_success_callback(backing_erase_invoke_count + backing_erase_sector_invoke_count)) {
+        return false;
+    }
+
+    // Erase each slot within the sector containing the address
+    std::size_t sector_start = address - (address % BACKING_STORE_SECTOR_SIZE::value);
+    for (std::size_t i = sector_start; i < sector_start + BACKING_STORE_SECTOR_SIZE::value; i += BACKING_STORE_WRITE_SIZE) {
+        backing_storage[i / BACKING_STORE_WRITE_SIZE].erase();
+    }
+    ++sector_erases[sector_start / BACKING_STORE_SECTOR_SIZE::value];
+    backing_elapsed_us += MOCK_BACKING_STORE_ERASE_TIME_US;
+
+    next_address = sector_start + BACKING_STORE_SECTOR_SIZE::value;
+    return true;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -97,10 +129,26 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
 
     // Keep track of the total number of writes into the backing store
     ++backing_total_write_count;
+    backing_elapsed_us += MOCK_BACKING_STORE_WRITE_TIME_US;
 
     return true;
 }
 
+bool MockBackingStore::poll(bool& busy) {
+    busy = backing_busy_polls > 0;
+    if (busy) {
+        --backing_busy_polls;
+        return true;
+    }
+
+    // Report a failed background operation once it has completed
+    if (backing_busy_fails) {
+        backing_busy_fails = false;
+        return false;
+    }
+    return true;
+}
+
 bool MockBackingStore::lock(void) {
     ++backing_lock_invoke_count;
 
@@ -141,6 +189,14 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" bool backing_store_erase_sector(uint32_t address, uint32_t* next_address) {
+    return MockBackingStore::Instance().erase_sector(address, *next_address);
+}
+
+extern "C" bool backing_store_poll(bool* busy) {
+    return MockBackingStore::Instance().poll(*busy);
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -21,6 +21,21 @@ using MOCK_WRITE_LOG_MAX_ENTRIES = std::integral_constant<std::size_t, 1024>;
 using BACKING_STORE_INTEGRAL_COMPLEMENT = std::integral_constant<backing_store_int_t, ((backing_store_int_t)(~(backing_store_int_t)0))>;
 // Total number of elements stored in the backing arrays
 using BACKING_STORE_ELEMENT_COUNT = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / sizeof(backing_store_int_t))>;
+// Size of each individually-erasable sector of the backing store
+#ifndef MOCK_BACKING_STORE_SECTOR_SIZE
+#    define MOCK_BACKING_STORE_SECTOR_SIZE 16
+#endif
+using BACKING_STORE_SECTOR_SIZE = std::integral_constant<std::size_t, MOCK_BACKING_STORE_SECTOR_SIZE>;
+// Total number of individually-erasable sectors
+using BACKING_STORE_SECTOR_COUNT = std::integral_constant<std::size_t, ((WEAR_LEVELING_BACKING_SIZE + MOCK_BACKING_STORE_SECTOR_SIZE - 1) / MOCK_BACKING_STORE_SECTOR_SIZE)>;
+// Simulated time taken by each write of the backing store integral, in microseconds
+#ifndef MOCK_BACKING_STORE_WRITE_TIME_US
+#    define MOCK_BACKING_STORE_WRITE_TIME_US 50
+#endif
+// Simulated time taken by each sector erase, in microseconds
+#ifndef MOCK_BACKING_STORE_ERASE_TIME_US
+#    define MOCK_BACKING_STORE_ERASE_TIME_US 40000
+#endif
 
 class MockBackingStoreElement {
    private:
@@ -89,11 +104,20 @@ class MockBackingStore {
     std::uint64_t backing_total_write_count;
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
+    // The number of erase cycles each sector has been through
+    std::array<std::uint64_t, BACKING_STORE_SECTOR_COUNT::value> sector_erases;
+    // The simulated time spent in writes and erases, in microseconds
+    std::uint64_t backing_elapsed_us;
+    // The number of further polls for which the backing store reports itself busy
+    std::uint64_t backing_busy_polls;
+    // Whether the operation completing in the background fails
+    bool backing_busy_fails;
 
     // The number of times each API was invoked
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_sector_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
 
@@ -130,6 +154,15 @@ class MockBackingStore {
     std::uint64_t total_write_count() const {
         return backing_total_write_count;
     }
+    std::uint64_t sector_erase_count(std::size_t sector) const {
+        return sector_erases[sector];
+    }
+    std::uint64_t max_sector_erase_count() const {
+        return *std::max_element(sector_erases.begin(), sector_erases.end());
+    }
+    std::uint64_t elapsed_us() const {
+        return backing_elapsed_us;
+    }
 
     // The number of times each API was invoked
     std::uint64_t init_invoke_count() const {
@@ -141,6 +174,9 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_sector_invoke_count() const {
+        return backing_erase_sector_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
@@ -159,6 +195,8 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_sector(std::uint32_t address, std::uint32_t& next_address);
+    bool poll(bool& busy);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -179,6 +217,11 @@ class MockBackingStore {
     void set_lock_callback(std::function<bool(std::uint64_t)> callback) {
         lock_success_callback = callback;
     }
+    // Simulate an operation completing in the background, over the given number of polls
+    void set_busy_polls(std::uint64_t polls, bool fails = false) {
+        backing_busy_polls = polls;
+        backing_busy_fails = fails;
+    }
 
     auto storage_begin() const -> decltype(backing_storage.begin()) {
         return backing_storage.begin();
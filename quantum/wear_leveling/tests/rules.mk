@@ -63,4 +63,37 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_incremental_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_SLICE_SIZE=8
+wear_leveling_incremental_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_incremental.cpp
+wear_leveling_incremental_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_endurance_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=2048 \
+	-DMOCK_BACKING_STORE_SECTOR_SIZE=2048
+wear_leveling_endurance_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_endurance.cpp
+wear_leveling_endurance_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_endurance_incremental_DEFS := \
+	$(wear_leveling_endurance_DEFS) \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+wear_leveling_endurance_incremental_SRC := \
+	$(wear_leveling_endurance_SRC)
+wear_leveling_endurance_incremental_INC := \
+	$(wear_leveling_common_INC)
@@ -3,4 +3,7 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_incremental \
+	wear_leveling_endurance \
+	wear_leveling_endurance_incremental
@@ -0,0 +1,173 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <cstdio>
+#include <functional>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Rated erase cycles of the flash being simulated, used to estimate its lifetime
+#define FLASH_ENDURANCE_CYCLES 10000
+// Number of times each workload is repeated
+#define WORKLOAD_REPETITIONS 20
+
+// Logical layout loosely following eeconfig and the dynamic keymap
+#define RGBLIGHT_ADDRESS 0x08
+#define KEYMAP_ADDRESS 0x40
+#define KEYMAP_SIZE (4 * 5 * 15 * 2)
+#define MACRO_ADDRESS (KEYMAP_ADDRESS + KEYMAP_SIZE)
+#define MACRO_SIZE 0x300
+#define VIA_CHUNK_SIZE 28
+
+static_assert(MACRO_ADDRESS + MACRO_SIZE <= WEAR_LEVELING_LOGICAL_SIZE, "Workload layout exceeds the logical size");
+
+// Replays realistic write workloads through the wear-leveling layer on top of the simulated backing store, and reports
+// how hard the flash is worked. The simulated costs are deterministic, so the report is stable between runs -- the
+// checks only cover data integrity and, with incremental consolidation, that writes never wait on an erase.
+class WearLevelingEndurance : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+        changed_bytes  = 0;
+        worst_write_us = 0;
+        worst_task_us  = 0;
+        rng_state      = 0x12345678;
+    }
+
+    std::uint32_t rng(void) {
+        rng_state = rng_state * 1664525 + 1013904223;
+        return rng_state >> 8;
+    }
+
+    // Writes through the wear-leveling layer, tracking the expected contents and the time taken
+    void write(std::uint32_t address, const void* data, std::size_t length) {
+        auto&          inst = MockBackingStore::Instance();
+        const uint8_t* p    = static_cast<const uint8_t*>(data);
+        for (std::size_t i = 0; i < length; ++i) {
+            changed_bytes += (expected[address + i] != p[i]) ? 1 : 0;
+            expected[address + i] = p[i];
+        }
+
+        std::uint64_t start = inst.elapsed_us();
+        EXPECT_NE(wear_leveling_write(address, data, length), WEAR_LEVELING_FAILED) << "Write failed";
+        worst_write_us = std::max(worst_write_us, inst.elapsed_us() - start);
+
+        // The main loop runs between each change
+        task();
+    }
+
+    void task(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+        auto&         inst  = MockBackingStore::Instance();
+        std::uint64_t start = inst.elapsed_us();
+        EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Task failed";
+        worst_task_us = std::max(worst_task_us, inst.elapsed_us() - start);
+#endif
+    }
+
+    void verify_readback(void) {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, expected) << "Invalid readback";
+    }
+
+    void run(const char* name, std::function<void(void)> workload) {
+        auto& inst = MockBackingStore::Instance();
+        for (int i = 0; i < WORKLOAD_REPETITIONS; ++i) {
+            workload();
+        }
+        verify_readback();
+
+        // Let any in-progress consolidation complete, then make sure the data survives a power cycle
+        for (int i = 0; i < 1000; ++i) {
+            task();
+        }
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed";
+        verify_readback();
+
+        double        amplification = changed_bytes ? (double)(inst.total_write_count() * BACKING_STORE_WRITE_SIZE) / changed_bytes : 0;
+        std::uint64_t max_erases    = inst.max_sector_erase_count();
+        printf("%-16s %8u bytes changed %8.2fx write amplification %5u max sector erases ", name, (unsigned)changed_bytes, amplification, (unsigned)max_erases);
+        if (max_erases > 0) {
+            printf("%10llu repetitions lifetime ", (unsigned long long)(FLASH_ENDURANCE_CYCLES * WORKLOAD_REPETITIONS / max_erases));
+        } else {
+            printf("%10s repetitions lifetime ", "unlimited");
+        }
+        printf("%8.2f ms worst write %8.2f ms worst task\n", worst_write_us / 1000.0, worst_task_us / 1000.0);
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+        EXPECT_LT(worst_write_us, MOCK_BACKING_STORE_ERASE_TIME_US) << "A write waited on a sector erase";
+        EXPECT_LE(worst_task_us, MOCK_BACKING_STORE_ERASE_TIME_US + (WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE / BACKING_STORE_WRITE_SIZE + 8) * MOCK_BACKING_STORE_WRITE_TIME_US) << "A task step did more than one erase or slice";
+#endif
+        EXPECT_EQ(inst.erase_invoke_count() * BACKING_STORE_SECTOR_COUNT::value + inst.erase_sector_invoke_count(), [&] {
+            std::uint64_t total = 0;
+            for (std::size_t i = 0; i < BACKING_STORE_SECTOR_COUNT::value; ++i) {
+                total += inst.sector_erase_count(i);
+            }
+            return total;
+        }()) << "Sector erase accounting mismatch";
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected;
+    std::size_t                                          changed_bytes;
+    std::uint64_t                                        worst_write_us;
+    std::uint64_t                                        worst_task_us;
+    std::uint32_t                                        rng_state;
+};
+
+/**
+ * Individual keycode changes made through VIA, mostly setting keys to KC_NO or KC_TRNS, followed by a full layout load.
+ */
+TEST_F(WearLevelingEndurance, VIAEdits) {
+    run("VIA edits", [&] {
+        for (int i = 0; i < 100; ++i) {
+            std::uint32_t key     = rng() % (KEYMAP_SIZE / 2);
+            std::uint16_t keycode = (rng() % 3 == 0) ? (std::uint16_t)(rng() % 2) : (std::uint16_t)(rng() & 0x7FFF);
+            std::uint8_t  data[2] = {(std::uint8_t)(keycode >> 8), (std::uint8_t)keycode};
+            write(KEYMAP_ADDRESS + key * 2, data, sizeof(data));
+        }
+
+        std::uint8_t layout[KEYMAP_SIZE];
+        for (auto& b : layout) {
+            b = (std::uint8_t)rng();
+        }
+        for (std::uint32_t offset = 0; offset < KEYMAP_SIZE; offset += VIA_CHUNK_SIZE) {
+            write(KEYMAP_ADDRESS + offset, &layout[offset], std::min<std::size_t>(VIA_CHUNK_SIZE, KEYMAP_SIZE - offset));
+        }
+    });
+}
+
+/**
+ * Dragging the RGB hue slider from one end to the other, saving the rgblight config at each step.
+ */
+TEST_F(WearLevelingEndurance, RGBSliderDrag) {
+    run("RGB slider drag", [&] {
+        for (int hue = 0; hue < 256; hue += 4) {
+            std::uint32_t config = 0x01 | (0x0A << 1) | ((std::uint32_t)hue << 8) | (0xFF << 16) | (0xC8 << 24);
+            write(RGBLIGHT_ADDRESS, &config, sizeof(config));
+        }
+    });
+}
+
+/**
+ * Recording macros, each of which is saved through VIA as a series of chunked buffer writes.
+ */
+TEST_F(WearLevelingEndurance, MacroRecording) {
+    run("macro recording", [&] {
+        for (int macro = 0; macro < 8; ++macro) {
+            std::uint8_t  buffer[96];
+            std::uint32_t length = 16 + rng() % (sizeof(buffer) - 16);
+            for (std::uint32_t i = 0; i < length; ++i) {
+                buffer[i] = 'a' + rng() % 26;
+            }
+            buffer[length - 1] = 0;
+
+            std::uint32_t base = MACRO_ADDRESS + (rng() % (MACRO_SIZE - sizeof(buffer)));
+            for (std::uint32_t offset = 0; offset < length; offset += VIA_CHUNK_SIZE) {
+                write(base + offset, &buffer[offset], std::min<std::size_t>(VIA_CHUNK_SIZE, length - offset));
+            }
+        }
+    });
+}
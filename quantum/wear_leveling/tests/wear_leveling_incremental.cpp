@@ -0,0 +1,277 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    // Writes a distinct value to each logical byte in turn until consolidation has been started
+    void write_until_consolidation_started(uint8_t seed) {
+        auto&    inst     = MockBackingStore::Instance();
+        uint64_t erases   = inst.erase_sector_invoke_count();
+        uint32_t attempts = 0;
+        while (true) {
+            uint8_t value = seed + attempts;
+            EXPECT_EQ(wear_leveling_write(16 + (attempts % 8), &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should not have consolidated inline";
+            expected[16 + (attempts % 8)] = value;
+            ++attempts;
+            ASSERT_LT(attempts, 1000u) << "Consolidation was never started";
+
+            // Consolidation has started once the task has work to do
+            EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+            if (inst.erase_sector_invoke_count() != erases) {
+                return;
+            }
+        }
+    }
+
+    // Catching up may not need to write anything for a slice, so consolidation is only finished once the task has had
+    // nothing to do for longer than it takes to check every slice
+    void run_until_idle(void) {
+        auto& inst = MockBackingStore::Instance();
+        int   idle = 0;
+        for (int i = 0; i < 1000; ++i) {
+            uint64_t writes = inst.write_invoke_count();
+            uint64_t erases = inst.erase_sector_invoke_count();
+            EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+            idle = (writes == inst.write_invoke_count() && erases == inst.erase_sector_invoke_count()) ? idle + 1 : 0;
+            if (idle > WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE) {
+                return;
+            }
+        }
+        FAIL() << "Consolidation did not complete";
+    }
+
+    void verify_readback(void) {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            EXPECT_EQ(readback[i], expected[i]) << "Invalid readback at offset " << i;
+        }
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+};
+
+/**
+ * This test verifies that consolidation is performed through the task in bounded steps, without erasing the whole backing store.
+ */
+TEST_F(WearLevelingIncremental, ConsolidatesInSteps) {
+    auto& inst = MockBackingStore::Instance();
+    std::iota(expected.begin(), expected.end(), 0x20);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    write_until_consolidation_started(0x80);
+    run_until_idle();
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "The whole backing store should never be erased";
+    EXPECT_EQ(inst.erase_sector_invoke_count(), (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_BACKING_STORE_SECTOR_SIZE) << "Only the inactive bank should be erased";
+    verify_readback();
+
+    // Re-init, which should pick the newly-consolidated bank
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+
+    // Second round of consolidation should go back to the first bank
+    write_until_consolidation_started(0xC0);
+    run_until_idle();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that consolidation does not proceed while the backing store is still completing an erase in the background.
+ */
+TEST_F(WearLevelingIncremental, WaitsForBusyBackingStore) {
+    auto& inst = MockBackingStore::Instance();
+    std::iota(expected.begin(), expected.end(), 0x50);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    write_until_consolidation_started(0x90);
+    inst.set_busy_polls(3);
+    uint64_t writes = inst.write_invoke_count();
+    uint64_t erases = inst.erase_sector_invoke_count();
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(inst.write_invoke_count(), writes) << "Backing store was written while busy";
+        EXPECT_EQ(inst.erase_sector_invoke_count(), erases) << "Backing store was erased while busy";
+    }
+    verify_readback();
+
+    run_until_idle();
+    EXPECT_EQ(inst.erase_sector_invoke_count(), (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_BACKING_STORE_SECTOR_SIZE) << "Only the inactive bank should be erased";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that consolidation is abandoned, and later started over, if an erase completing in the background fails.
+ */
+TEST_F(WearLevelingIncremental, BackgroundEraseFailure) {
+    auto& inst = MockBackingStore::Instance();
+    std::iota(expected.begin(), expected.end(), 0x60);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    write_until_consolidation_started(0xA0);
+    inst.set_busy_polls(1, true);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should wait for the erase to complete";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Task should report the failed erase";
+
+    // Nothing further should be erased or written until consolidation is started again
+    uint64_t writes = inst.write_invoke_count();
+    uint64_t erases = inst.erase_sector_invoke_count();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    }
+    EXPECT_EQ(inst.write_invoke_count(), writes) << "Backing store was written after the failed erase";
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erases) << "Consolidation continued after the failed erase";
+    verify_readback();
+
+    // The next write restarts consolidation from the first sector of the inactive bank
+    write_until_consolidation_started(0xB0);
+    run_until_idle();
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erases + (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_BACKING_STORE_SECTOR_SIZE) << "The inactive bank should be erased again in full";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that writes made while consolidation is in progress are retained, including those to data that was already copied.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringConsolidation) {
+    std::iota(expected.begin(), expected.end(), 0x40);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    write_until_consolidation_started(0x10);
+    for (int i = 0; i < 64; ++i) {
+        // Interleave writes to the start and end of the logical area with consolidation steps
+        uint8_t value                            = 0xA0 + i;
+        expected[i % 4]                          = value;
+        expected[WEAR_LEVELING_LOGICAL_SIZE - 1] = value ^ 0xFF;
+        EXPECT_NE(wear_leveling_write(i % 4, &value, sizeof(value)), WEAR_LEVELING_FAILED);
+        value ^= 0xFF;
+        EXPECT_NE(wear_leveling_write(WEAR_LEVELING_LOGICAL_SIZE - 1, &value, sizeof(value)), WEAR_LEVELING_FAILED);
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+        verify_readback();
+    }
+    run_until_idle();
+    verify_readback();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that a write straddling the data already caught up is not left stale in the new bank, once the part
+ * not yet caught up is put back to its consolidated value.
+ */
+TEST_F(WearLevelingIncremental, WriteStraddlingCatchUp) {
+    std::iota(expected.begin(), expected.end(), 0x30);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    // Run the remaining erases, the copy, then catch up the first slice
+    write_until_consolidation_started(0x70);
+    const int steps = (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_BACKING_STORE_SECTOR_SIZE - 1 + WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE + 1;
+    for (int i = 0; i < steps; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    }
+
+    // Change data either side of the end of the first slice, then restore the part that has not been caught up yet
+    const uint32_t boundary    = WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE;
+    uint8_t        straddle[4] = {0xE0, 0xE1, 0xE2, 0xE3};
+    EXPECT_NE(wear_leveling_write(boundary - 2, straddle, sizeof(straddle)), WEAR_LEVELING_FAILED);
+    EXPECT_NE(wear_leveling_write(boundary, &expected[boundary], 2), WEAR_LEVELING_FAILED);
+    expected[boundary - 2] = straddle[0];
+    expected[boundary - 1] = straddle[1];
+    verify_readback();
+
+    run_until_idle();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that consolidation is completed immediately if the write log fills up before the task has run.
+ */
+TEST_F(WearLevelingIncremental, FullLogForcesCompletion) {
+    auto& inst         = MockBackingStore::Instance();
+    bool  consolidated = false;
+    for (int i = 0; i < 200; ++i) {
+        uint8_t value           = i + 1;
+        expected[16 + (i % 16)] = value;
+
+        wear_leveling_status_t status = wear_leveling_write(16 + (i % 16), &value, sizeof(value));
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        consolidated |= (status == WEAR_LEVELING_CONSOLIDATED);
+    }
+    EXPECT_TRUE(consolidated) << "A full write log should have forced consolidation";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "The whole backing store should never be erased";
+    verify_readback();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that an interrupted consolidation leaves the previous bank in use.
+ */
+TEST_F(WearLevelingIncremental, InterruptedConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    std::iota(expected.begin(), expected.end(), 0x60);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    write_until_consolidation_started(0x30);
+
+    // Finish erasing and copy part of the cache, then "lose power"
+    uint64_t writes = inst.write_invoke_count();
+    while (inst.write_invoke_count() == writes) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+
+    // Consolidation should be restarted, as the write log is still nearly full
+    uint64_t erases = inst.erase_sector_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erases + 1) << "Consolidation should have been restarted by init";
+    run_until_idle();
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erases + (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_BACKING_STORE_SECTOR_SIZE) << "The inactive bank should have been erased again from the start";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+
+    // The restarted consolidation switched banks, so the next one should not start until the new write log fills up
+    erases = inst.erase_sector_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erases) << "No consolidation should be pending after switching banks";
+}
+
+/**
+ * This test verifies that power loss after any consolidation step retains every write, including those made to data
+ * which had already been copied into the new bank.
+ */
+TEST_F(WearLevelingIncremental, PowerLossDuringConsolidation) {
+    for (int steps = 0; steps < 40; ++steps) {
+        MockBackingStore::Instance().reset_instance();
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        std::iota(expected.begin(), expected.end(), 0x70);
+        EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+        write_until_consolidation_started(0x20);
+        for (int i = 0; i < steps; ++i) {
+            uint8_t value   = 0xB0 + i;
+            expected[i % 4] = value;
+            EXPECT_NE(wear_leveling_write(i % 4, &value, sizeof(value)), WEAR_LEVELING_FAILED);
+            EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+        }
+
+        // "Lose power"
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status after " << steps << " steps";
+        verify_readback();
+    }
+}
@@ -61,6 +61,10 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_READ_BULK_COUNT: The number of backing store values
+            read at a time when scanning the backing store, such as during
+            playback of the write log. Each value is held on the stack.
+
     General algorithm:
 
         During initialization:
@@ -153,7 +157,58 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Incremental consolidation:
+
+        Erasing the backing store and rewriting the consolidated data can take
+        long enough on embedded flash to stall the keyboard. With
+        WEAR_LEVELING_INCREMENTAL_CONSOLIDATION defined, the backing store is
+        split into two banks, each with its own consolidated data and write
+        log. Only one bank is active at any one time.
+
+        Each bank stores a generation counter after the FNV1a_64 hash, which is
+        also included in the hash. On startup the bank with a valid hash and
+        the highest generation is played back.
+
+        Once the active write log is nearly full, consolidation into the other
+        bank is started, and is performed in bounded steps from
+        wear_leveling_task():
+            * The other bank is erased, a sector at a time.
+            * The cache is written to it, a slice at a time.
+            * Any logical data that changed while the cache was being copied
+                is appended to the other bank's write log.
+            * The generation and hash are written, and the bank becomes active.
+
+        Until the generation and hash are written the previous bank remains
+        valid, so power loss at any point leaves either the previous bank, or
+        the new bank with every change replayed into its write log.
+
+        Writes made while consolidation is in progress are still appended to
+        the active write log. If it fills up, the remaining steps are performed
+        immediately. If the other bank's write log fills up while changes are
+        being replayed into it, consolidation starts over. */
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16) // +16 due to the FNV1a_64 of the consolidated area, and the generation
+#    define WEAR_LEVELING_ACTIVE_BANK (wear_leveling.bank_address)
+#    ifndef WEAR_LEVELING_CONSOLIDATION_HEADROOM
+#        define WEAR_LEVELING_CONSOLIDATION_HEADROOM ((((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET)) / 4) & ~((BACKING_STORE_WRITE_SIZE)-1))
+#    endif
+
+typedef enum consolidation_state_t {
+    CONSOLIDATION_IDLE,
+    CONSOLIDATION_ERASING,
+    CONSOLIDATION_COPYING,
+    CONSOLIDATION_CATCHING_UP,
+    CONSOLIDATION_FINALISING,
+} consolidation_state_t;
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 8) // +8 due to the FNV1a_64 of the consolidated area
+#    define WEAR_LEVELING_ACTIVE_BANK 0
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,6 +217,18 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    uint32_t bank_address;
+    uint64_t generation;
+    struct {
+        consolidation_state_t state;
+        uint32_t              bank;
+        uint32_t              address;
+        uint32_t              write_address; // next free slot in the new bank's write log
+        bool                  replaying;     // whether write log appends are currently directed at the new bank
+        uint64_t              hash;
+    } consolidation;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 } wear_leveling;
 
 /**
@@ -197,14 +264,48 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+/**
+ * Buffered sequential reads from the backing store, so that scans can make use of bulk reads.
+ */
+typedef struct backing_store_reader_t {
+    backing_store_int_t buffer[(WEAR_LEVELING_READ_BULK_COUNT)];
+    uint32_t            address; // backing store address of buffer[0]
+    uint32_t            count;   // number of values held in the buffer
+    uint32_t            limit;   // end of the region being scanned, which is never read past
+} backing_store_reader_t;
+
+static void wear_leveling_reader_init(backing_store_reader_t *reader, uint32_t limit) {
+    reader->address = 0;
+    reader->count   = 0;
+    reader->limit   = limit;
+}
+
+static bool wear_leveling_reader_read(backing_store_reader_t *reader, uint32_t address, backing_store_int_t *value) {
+    if (address < reader->address || address >= reader->address + reader->count * (BACKING_STORE_WRITE_SIZE)) {
+        uint32_t count = (address < reader->limit) ? (reader->limit - address) / (BACKING_STORE_WRITE_SIZE) : 0;
+        if (count > (WEAR_LEVELING_READ_BULK_COUNT)) {
+            count = (WEAR_LEVELING_READ_BULK_COUNT);
+        }
+        if (count == 0 || !backing_store_read_bulk(address, reader->buffer, count)) {
+            reader->count = 0;
+            return false;
+        }
+        reader->address = address;
+        reader->count   = count;
+    }
+    *value = reader->buffer[(address - reader->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_LOG_OFFSET);
 }
 
+#ifndef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -316,7 +417,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_OFFSET);
 
     return status;
 }
@@ -335,6 +436,306 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
 
     return WEAR_LEVELING_SUCCESS;
 }
+#else  // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+/**
+ * Reads a 64-bit value, such as the consolidated area's FNV1a_64 hash, from the backing store.
+ */
+static bool wear_leveling_read_u64(uint32_t address, uint64_t *value) {
+    write_log_entry_t entry;
+#if BACKING_STORE_WRITE_SIZE == 2
+    bool ok = backing_store_read_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    bool ok = backing_store_read_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    bool ok = backing_store_read(address, &entry.raw64);
+#endif
+    *value = entry.raw64;
+    return ok;
+}
+
+/**
+ * Writes a 64-bit value, such as the consolidated area's FNV1a_64 hash, to the backing store.
+ */
+static bool wear_leveling_write_u64(uint32_t address, uint64_t value) {
+    write_log_entry_t entry = {.raw64 = value};
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry.raw64);
+#endif
+}
+
+/**
+ * Computes the FNV1a_64 hash of the consolidated data held in a bank of the backing store, including its generation.
+ */
+static bool wear_leveling_hash_bank(uint32_t bank, uint64_t generation, uint64_t *hash) {
+    backing_store_reader_t reader;
+    wear_leveling_reader_init(&reader, bank + (WEAR_LEVELING_LOGICAL_SIZE));
+
+    uint64_t h = FNV1A_64_INIT;
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_LOGICAL_SIZE); offset += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!wear_leveling_reader_read(&reader, bank + offset, &value)) {
+            return false;
+        }
+        h = fnv_64a_buf(&value, sizeof(value), h);
+    }
+    *hash = fnv_64a_buf(&generation, sizeof(generation), h);
+    return true;
+}
+
+/**
+ * Selects the bank holding the newest valid consolidated data, and reads its consolidated data into the cache.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    bool     found     = false;
+    uint32_t best_bank = 0;
+    uint64_t best_gen  = 0;
+    for (uint32_t bank = 0; bank < (WEAR_LEVELING_BACKING_SIZE); bank += (WEAR_LEVELING_BANK_SIZE)) {
+        uint64_t expected, generation, hash;
+        if (!wear_leveling_read_u64(bank + (WEAR_LEVELING_LOGICAL_SIZE), &expected) || !wear_leveling_read_u64(bank + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &generation) || !wear_leveling_hash_bank(bank, generation, &hash)) {
+            wl_dprintf("Failed to read from backing store\n");
+            wear_leveling_clear_cache();
+            return WEAR_LEVELING_FAILED;
+        }
+        if (hash == expected && (!found || generation > best_gen)) {
+            found     = true;
+            best_bank = bank;
+            best_gen  = generation;
+        }
+    }
+
+    wear_leveling.bank_address = best_bank;
+    wear_leveling.generation   = best_gen;
+
+    // If neither bank is valid, start from a clear cache but do not flag a failure, which will cater for the completely clean MCU case.
+    if (!found) {
+        wl_dprintf("No valid consolidated data, clearing cache\n");
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Using consolidated data at 0x%08lX\n", (unsigned long)best_bank);
+    wear_leveling.write_address = best_bank + (WEAR_LEVELING_LOG_OFFSET);
+    if (!backing_store_read_bulk(best_bank, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+        wl_dprintf("Failed to read from backing store\n");
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const void *value, size_t length);
+
+/**
+ * Starts consolidation into the inactive bank.
+ */
+static void wear_leveling_consolidation_start(void) {
+    wl_dprintf("Starting consolidation\n");
+    wear_leveling.consolidation.state   = CONSOLIDATION_ERASING;
+    wear_leveling.consolidation.bank    = (wear_leveling.bank_address == 0) ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    wear_leveling.consolidation.address = wear_leveling.consolidation.bank;
+}
+
+/**
+ * Appends logical data to the new bank's write log, leaving the active bank untouched as the new bank is not yet valid.
+ * If the new bank's write log fills up, consolidation starts over with a fresh copy of the cache.
+ */
+static wear_leveling_status_t wear_leveling_consolidation_replay(uint32_t address, const void *value, size_t length) {
+    const uint32_t active_write_address   = wear_leveling.write_address;
+    wear_leveling.write_address           = wear_leveling.consolidation.write_address;
+    wear_leveling.consolidation.replaying = true;
+
+    wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+
+    wear_leveling.consolidation.replaying     = false;
+    wear_leveling.consolidation.write_address = wear_leveling.write_address;
+    wear_leveling.write_address               = active_write_address;
+
+    // Consolidated here means the new bank's write log is full, rather than that anything was consolidated
+    if (status == WEAR_LEVELING_CONSOLIDATED) {
+        wl_dprintf("New write log full, restarting consolidation\n");
+        wear_leveling_consolidation_start();
+    }
+    return status;
+}
+
+/**
+ * Appends any logical data differing from the new bank's consolidated data to the new bank's write log, a slice at a time.
+ */
+static wear_leveling_status_t wear_leveling_consolidation_catch_up(void) {
+    const uint32_t bank  = wear_leveling.consolidation.bank;
+    const uint32_t start = wear_leveling.consolidation.address;
+    const uint32_t end   = (start + (WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE) < (WEAR_LEVELING_LOGICAL_SIZE)) ? start + (WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE) : (WEAR_LEVELING_LOGICAL_SIZE);
+    uint32_t       run   = end; // start of the current run of changed data, or end if there isn't one
+
+    backing_store_reader_t reader;
+    wear_leveling_reader_init(&reader, bank + end);
+    for (uint32_t offset = start; offset <= end; offset += (BACKING_STORE_WRITE_SIZE)) {
+        bool changed = false;
+        if (offset < end) {
+            backing_store_int_t value;
+            if (!wear_leveling_reader_read(&reader, bank + offset, &value)) {
+                return WEAR_LEVELING_FAILED;
+            }
+            changed = memcmp(&value, &wear_leveling.cache[offset], sizeof(value)) != 0;
+        }
+
+        if (changed && run == end) {
+            run = offset;
+        } else if (!changed && run != end) {
+            wear_leveling_status_t status = wear_leveling_consolidation_replay(run, &wear_leveling.cache[run], offset - run);
+            if (status == WEAR_LEVELING_CONSOLIDATED) {
+                // Consolidation has been restarted, nothing left to catch up
+                return WEAR_LEVELING_SUCCESS;
+            }
+            if (status != WEAR_LEVELING_SUCCESS) {
+                return status;
+            }
+            run = end;
+        }
+    }
+
+    wear_leveling.consolidation.address = end;
+    if (end >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+        wear_leveling.consolidation.state = CONSOLIDATION_FINALISING;
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Performs the next bounded step of consolidation.
+ */
+static wear_leveling_status_t wear_leveling_consolidation_step(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    wear_leveling_status_t      status      = WEAR_LEVELING_SUCCESS;
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    const uint32_t bank    = wear_leveling.consolidation.bank;
+    const uint32_t address = wear_leveling.consolidation.address;
+    switch (wear_leveling.consolidation.state) {
+        case CONSOLIDATION_ERASING: {
+            // Erase the inactive bank, a sector at a time. Drivers never erase a sector extending outside the bank containing
+            // the address, so a sector running past the end of this bank means the erase went wrong.
+            uint32_t next_address;
+            if (!backing_store_erase_sector(address, &next_address) || next_address <= address || next_address > bank + (WEAR_LEVELING_BANK_SIZE)) {
+                wl_dprintf("Failed to erase backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wear_leveling.consolidation.address = next_address;
+            if (next_address >= bank + (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation.state   = CONSOLIDATION_COPYING;
+                wear_leveling.consolidation.address = 0;
+                wear_leveling.consolidation.hash    = FNV1A_64_INIT;
+            }
+        } break;
+
+        case CONSOLIDATION_COPYING: {
+            // Copy the cache into the inactive bank, a slice at a time, hashing exactly what was written
+            const uint32_t length = (address + (WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE) < (WEAR_LEVELING_LOGICAL_SIZE)) ? (WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE) : (WEAR_LEVELING_LOGICAL_SIZE) - address;
+            if (!backing_store_write_bulk(bank + address, (backing_store_int_t *)&wear_leveling.cache[address], length / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write to backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wear_leveling.consolidation.hash = fnv_64a_buf(&wear_leveling.cache[address], length, wear_leveling.consolidation.hash);
+            wear_leveling.consolidation.address += length;
+            if (wear_leveling.consolidation.address >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.consolidation.state         = CONSOLIDATION_CATCHING_UP;
+                wear_leveling.consolidation.address       = 0;
+                wear_leveling.consolidation.write_address = bank + (WEAR_LEVELING_LOG_OFFSET);
+            }
+        } break;
+
+        case CONSOLIDATION_CATCHING_UP:
+            status = wear_leveling_consolidation_catch_up();
+            break;
+
+        case CONSOLIDATION_FINALISING: {
+            // Write the generation then the hash, after which the inactive bank and its write log are valid -- switch over to it
+            uint64_t       generation = wear_leveling.generation + 1;
+            const uint64_t hash       = fnv_64a_buf(&generation, sizeof(generation), wear_leveling.consolidation.hash);
+            if (!wear_leveling_write_u64(bank + (WEAR_LEVELING_LOGICAL_SIZE) + 8, generation) || !wear_leveling_write_u64(bank + (WEAR_LEVELING_LOGICAL_SIZE), hash)) {
+                wl_dprintf("Failed to write checksum\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wl_dprintf("Consolidation complete\n");
+            wear_leveling.bank_address        = bank;
+            wear_leveling.generation          = generation;
+            wear_leveling.write_address       = wear_leveling.consolidation.write_address;
+            wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+        } break;
+
+        default:
+            break;
+    }
+
+    if (status == WEAR_LEVELING_FAILED) {
+        // Abandon this attempt -- the inactive bank is erased again when consolidation is next started
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+    return status;
+}
+
+/**
+ * Runs consolidation through to completion, starting it if required.
+ * During this operation, there is the potential for data loss if a power loss occurs.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidation_start();
+    }
+
+    while (wear_leveling.consolidation.state != CONSOLIDATION_IDLE) {
+        if (wear_leveling_consolidation_step() == WEAR_LEVELING_FAILED) {
+            wl_dprintf("Failed to consolidate\n");
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Starts consolidation if the write log is nearly full, forcing its completion if the write log is full.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+    if (wear_leveling.consolidation.replaying) {
+        // Appending to the new bank's write log while catching up -- report when it is full, so that consolidation starts over
+        return (wear_leveling.write_address >= wear_leveling.consolidation.bank + (WEAR_LEVELING_BANK_SIZE)) ? WEAR_LEVELING_CONSOLIDATED : WEAR_LEVELING_SUCCESS;
+    }
+
+    if (wear_leveling.write_address >= wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE)) {
+        return wear_leveling_consolidate_force();
+    }
+
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address >= wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_CONSOLIDATION_HEADROOM)) {
+        wear_leveling_consolidation_start();
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Appends the supplied fixed-width entry to the write log, optionally consolidating if the log is full.
@@ -477,10 +878,14 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_LOG_OFFSET);
+
+    // Read the write log in bulk, rather than one value at a time
+    backing_store_reader_t reader;
+    wear_leveling_reader_init(&reader, WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE));
+    while (!cancel_playback && address < WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_reader_read(&reader, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +914,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_reader_read(&reader, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +934,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_reader_read(&reader, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +944,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_reader_read(&reader, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +955,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_reader_read(&reader, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -617,6 +1022,14 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Start from the first bank, until the consolidated data has been inspected
+    wear_leveling.bank_address            = 0;
+    wear_leveling.generation              = 0;
+    wear_leveling.consolidation.state     = CONSOLIDATION_IDLE;
+    wear_leveling.consolidation.replaying = false;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -661,6 +1074,11 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling.bank_address        = 0;
+    wear_leveling.generation          = 0;
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -698,6 +1116,19 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Data already replayed into the new bank's write log has changed again, so it needs appending there too. This is done
+    // first, as filling the active write log below forces consolidation to complete without revisiting this data. Anything
+    // past the data caught up so far is left to catch-up, which only appends what differs from the new bank's copy.
+    if ((wear_leveling.consolidation.state == CONSOLIDATION_CATCHING_UP || wear_leveling.consolidation.state == CONSOLIDATION_FINALISING) && address < wear_leveling.consolidation.address) {
+        const size_t caught_up = (address + length <= wear_leveling.consolidation.address) ? length : wear_leveling.consolidation.address - address;
+        if (wear_leveling_consolidation_replay(address, value, caught_up) == WEAR_LEVELING_FAILED) {
+            // The write still goes to the active write log -- only this consolidation attempt is abandoned
+            wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+        }
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     // Perform the actual write
     wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
     switch (status) {
@@ -743,6 +1174,38 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Performs the next bounded step of any in-progress consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Leave the backing store to finish any erase it is performing in the background, rather than waiting on it
+    bool busy;
+    if (!backing_store_poll(&busy)) {
+        // Abandon this attempt -- the inactive bank is erased again when consolidation is next started
+        wl_dprintf("Background erase failed\n");
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+        return WEAR_LEVELING_FAILED;
+    }
+    if (busy) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+    return wear_leveling_consolidation_step();
+}
+
+/**
+ * Weak implementation of the busy check, for drivers that complete their erases before returning.
+ */
+__attribute__((weak)) bool backing_store_poll(bool *busy) {
+    *busy = false;
+    return true;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -52,3 +52,12 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Performs the next bounded step of any in-progress consolidation.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_task(void);
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
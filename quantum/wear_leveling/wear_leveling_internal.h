@@ -61,11 +61,25 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+#ifndef WEAR_LEVELING_READ_BULK_COUNT
+#    define WEAR_LEVELING_READ_BULK_COUNT 32
+#endif // WEAR_LEVELING_READ_BULK_COUNT
+
 // Compile-time validation of configurable options
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    ifndef WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE 256
+#    endif
+
+_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 4), "Total backing size must be at least four times the size of the logical size when using incremental consolidation");
+_Static_assert((WEAR_LEVELING_BACKING_SIZE / 2) % BACKING_STORE_WRITE_SIZE == 0, "Half of the backing size must be a multiple of write size when using incremental consolidation");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_SLICE_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation slice size must be a multiple of write size");
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
@@ -75,6 +89,10 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t* next_address); // erases the sector containing the address, supplying the address of the next sector -- fails without erasing if that sector extends into the other half of the backing store
+bool backing_store_poll(bool* busy);                                        // weak implementation already provided, drivers that complete erases in the background report whether one is in progress -- fails if one did not complete
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Helper type used to contain a write log entry.
@@ -0,0 +1,11 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB565_SURFACE_NUM_DEVICES 2
+
+// Flash-backed assets are read from a RAM-backed stand-in, so the chip select is never driven
+#define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN NO_PIN
@@ -0,0 +1,15 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB565_SURFACE_NUM_DEVICES 3
+
+// Flash-backed assets are read from a RAM-backed stand-in, so the chip select is never driven
+#define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN NO_PIN
+
+// Room for 16 glyphs of the 3x5 test font, which draw as 4x6 RGB565 pixels -- the golden text needs more than that
+#define QUANTUM_PAINTER_GLYPH_CACHE_SIZE (16 * 4 * 6 * 2)
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 16
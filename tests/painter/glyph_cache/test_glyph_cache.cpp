@@ -0,0 +1,165 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+
+#include "test_common.hpp"
+#include "color.h"
+#include "../qp_host.h"
+#include "../test_assets.h"
+
+#define DISPLAY_WIDTH 64
+#define DISPLAY_HEIGHT 48
+
+// Flash addresses the fonts are written to, clear of each other
+#define FONT_ADDRESS 0x800
+#define PALETTE_FONT_ADDRESS 0xC00
+
+// Glyphs drawn from the cache are sent without touching the font, so flash-backed fonts are used to tell hits from
+// misses by the reads they cause.
+class QuantumPainterGlyphCache : public ::testing::Test {
+   protected:
+    static painter_device_t display;
+    static uint16_t         framebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+    void SetUp() override {
+        if (display == nullptr) {
+            display = qp_host_make_device(DISPLAY_WIDTH, DISPLAY_HEIGHT, framebuffer);
+        }
+        ASSERT_NE(display, nullptr);
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+        clear();
+        qp_host_flash_write(FONT_ADDRESS, font_test_3x5, font_test_3x5_length);
+        qp_host_flash_write(PALETTE_FONT_ADDRESS, font_test_3x5_palette, font_test_3x5_palette_length);
+        qp_host_flash_reset_stats();
+    }
+
+    void clear() {
+        ASSERT_TRUE(qp_rect(display, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1, 0, 0, 0, true));
+        qp_host_reset_stats(display);
+    }
+
+    // Whether two equally-sized areas of the display hold the same pixels
+    static bool same_pixels(int x1, int y1, int x2, int y2, int width, int height) {
+        for (int y = 0; y < height; ++y) {
+            if (memcmp(&framebuffer[(y1 + y) * DISPLAY_WIDTH + x1], &framebuffer[(y2 + y) * DISPLAY_WIDTH + x2], width * sizeof(uint16_t)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Compares the rendered output against its golden hash, dumping the image alongside the test binary on mismatch
+    void expect_golden(const char *name, uint32_t expected) {
+        uint32_t actual = qp_host_hash(display);
+        EXPECT_EQ(actual, expected) << "rendered output of '" << name << "' differs from golden";
+        if (actual != expected) {
+            std::string filename = std::string(".build/test/painter_glyph_cache_") + name + ".png";
+            if (qp_host_write_png(display, filename.c_str())) {
+                std::cerr << "Wrote " << filename << std::endl;
+            }
+        }
+    }
+};
+
+painter_device_t QuantumPainterGlyphCache::display = nullptr;
+uint16_t         QuantumPainterGlyphCache::framebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+TEST_F(QuantumPainterGlyphCache, redraws_cached_glyphs_without_decoding) {
+    painter_font_handle_t font = qp_load_font_flash(FONT_ADDRESS);
+    ASSERT_NE(font, nullptr);
+
+    EXPECT_EQ(qp_drawtext(display, 1, 1, font, "QMK"), 12);
+    EXPECT_GT(qp_host_flash_get_stats().reads, 0u);
+
+    // Each cached glyph is a single viewport and pixdata call, with nothing read from the font
+    qp_host_flash_reset_stats();
+    qp_host_reset_stats(display);
+    EXPECT_EQ(qp_drawtext(display, 1, 8, font, "QMK"), 12);
+    EXPECT_EQ(qp_textwidth(font, "KMQ"), 12);
+    qp_host_stats_t stats = qp_host_get_stats(display);
+    EXPECT_EQ(stats.viewport_calls, 3u);
+    EXPECT_EQ(stats.pixdata_calls, 3u);
+    EXPECT_EQ(stats.pixdata_bytes, 3u * 4 * 6 * 2);
+    EXPECT_EQ(qp_host_flash_get_stats().reads, 0u);
+    EXPECT_TRUE(same_pixels(1, 1, 1, 8, 12, 6));
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(QuantumPainterGlyphCache, evicts_and_compacts_least_recently_used_glyphs) {
+    painter_font_handle_t font = qp_load_font_mem(font_test_3x5);
+    ASSERT_NE(font, nullptr);
+
+    // Fill the cache, then touch every other glyph so that the least recently used ones are spread through the buffer
+    EXPECT_EQ(qp_drawtext(display, 0, 0, font, "abcdefghijklmnop"), 64);
+    EXPECT_EQ(qp_drawtext(display, 0, 0, font, "bdfhjlnp"), 32);
+    clear();
+
+    // The text golden has more distinct glyphs than the cache holds, so these evict and compact throughout, and have
+    // to match the uncached rendering -- both the first time and when redrawn from what's left in the cache
+    for (int pass = 0; pass < 2; ++pass) {
+        EXPECT_EQ(qp_drawtext(display, 1, 1, font, "Hello, QMK!"), 44);
+        EXPECT_EQ(qp_drawtext_recolor(display, 1, 8, font, "0123456789", HSV_GREEN, HSV_BLACK), 40);
+        EXPECT_EQ(qp_drawtext_recolor(display, 1, 15, font, "I \xE2\x99\xA5 QP", HSV_RED, HSV_BLUE), 24);
+        expect_golden("text", 0xB97AD0A5);
+        clear();
+    }
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(QuantumPainterGlyphCache, caches_recolored_glyphs_per_color) {
+    painter_font_handle_t font = qp_load_font_flash(FONT_ADDRESS);
+    ASSERT_NE(font, nullptr);
+
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 1, font, "QMK", HSV_RED, HSV_BLACK), 12);
+    qp_host_flash_reset_stats();
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 8, font, "QMK", HSV_GREEN, HSV_BLACK), 12);
+    EXPECT_GT(qp_host_flash_get_stats().reads, 0u) << "glyphs in another color must be decoded again";
+    qp_host_flash_reset_stats();
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 15, font, "QMK", HSV_RED, HSV_BLACK), 12);
+    EXPECT_EQ(qp_host_flash_get_stats().reads, 0u);
+
+    EXPECT_FALSE(same_pixels(1, 1, 1, 8, 12, 6));
+    EXPECT_TRUE(same_pixels(1, 1, 1, 15, 12, 6));
+    expect_golden("recolored", 0x33BC9522);
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(QuantumPainterGlyphCache, caches_palette_glyphs_regardless_of_color) {
+    painter_font_handle_t font = qp_load_font_flash(PALETTE_FONT_ADDRESS);
+    ASSERT_NE(font, nullptr);
+
+    // Fonts with their own palette ignore the requested colors, so any color hits the same cached glyphs
+    EXPECT_EQ(qp_drawtext(display, 1, 1, font, "QMK"), 12);
+    qp_host_flash_reset_stats();
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 8, font, "QMK", HSV_RED, HSV_BLUE), 12);
+    EXPECT_EQ(qp_host_flash_get_stats().reads, 0u);
+
+    EXPECT_TRUE(same_pixels(1, 1, 1, 8, 12, 6));
+    expect_golden("palette", 0xF4AF2835);
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(QuantumPainterGlyphCache, closing_a_font_drops_its_glyphs) {
+    painter_font_handle_t font = qp_load_font_mem(font_test_3x5);
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(qp_drawtext(display, 1, 1, font, "QMK"), 12);
+    EXPECT_TRUE(qp_close_font(font));
+
+    // The palette font is loaded into the slot just freed, so stale glyphs would otherwise be found for it
+    painter_font_handle_t palette_font = qp_load_font_flash(PALETTE_FONT_ADDRESS);
+    ASSERT_EQ(palette_font, font);
+    clear();
+    qp_host_flash_reset_stats();
+    EXPECT_EQ(qp_drawtext(display, 1, 1, palette_font, "QMK"), 12);
+    EXPECT_GT(qp_host_flash_get_stats().reads, 0u);
+    EXPECT_EQ(qp_drawtext(display, 1, 8, palette_font, "QMK"), 12);
+    expect_golden("palette", 0xF4AF2835);
+
+    EXPECT_TRUE(qp_close_font(palette_font));
+}
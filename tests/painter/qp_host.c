@@ -0,0 +1,307 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "qp_internal.h"
+#include "qp_host.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Device definition
+
+typedef struct qp_host_device_t {
+    painter_device_t        surface;
+    uint16_t *              buffer;
+    painter_driver_vtable_t driver_vtable;
+    painter_comms_vtable_t  comms_vtable;
+    qp_host_stats_t         stats;
+    bool                    comms_started;
+
+    // The surface's own implementations, which do the actual rendering
+    const painter_driver_vtable_t *surface_driver_vtable;
+    const painter_comms_vtable_t * surface_comms_vtable;
+} qp_host_device_t;
+
+static qp_host_device_t host_devices[QP_HOST_NUM_DEVICES] = {0};
+
+static qp_host_device_t *qp_host_find(painter_device_t device) {
+    for (int i = 0; i < QP_HOST_NUM_DEVICES; ++i) {
+        if (host_devices[i].surface == device) {
+            return &host_devices[i];
+        }
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counting wrappers around the surface vtables
+
+static bool qp_host_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    qp_host_device_t *host = qp_host_find(device);
+    host->stats.viewport_calls++;
+    return host->surface_driver_vtable->viewport(device, left, top, right, bottom);
+}
+
+static bool qp_host_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    qp_host_device_t *host  = qp_host_find(device);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    host->stats.pixdata_calls++;
+    host->stats.pixdata_bytes += (native_pixel_count * driver->native_bits_per_pixel + 7) / 8;
+    return host->surface_driver_vtable->pixdata(device, pixel_data, native_pixel_count);
+}
+
+static bool qp_host_comms_start(painter_device_t device) {
+    qp_host_device_t *host = qp_host_find(device);
+    host->stats.transactions++;
+    host->comms_started = host->surface_comms_vtable->comms_start(device);
+    return host->comms_started;
+}
+
+static void qp_host_comms_stop(painter_device_t device) {
+    qp_host_device_t *host = qp_host_find(device);
+    host->comms_started    = false;
+    host->surface_comms_vtable->comms_stop(device);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function
+
+painter_device_t qp_host_make_device(uint16_t width, uint16_t height, void *buffer) {
+    for (int i = 0; i < QP_HOST_NUM_DEVICES; ++i) {
+        qp_host_device_t *host = &host_devices[i];
+        if (host->surface == NULL) {
+            painter_device_t surface = qp_rgb565_make_surface(width, height, buffer);
+            if (surface == NULL) {
+                return NULL;
+            }
+
+            painter_driver_t *driver     = (painter_driver_t *)surface;
+            host->surface                = surface;
+            host->buffer                 = (uint16_t *)buffer;
+            host->surface_driver_vtable  = driver->driver_vtable;
+            host->surface_comms_vtable   = driver->comms_vtable;
+            host->driver_vtable          = *driver->driver_vtable;
+            host->driver_vtable.viewport = qp_host_viewport;
+            host->driver_vtable.pixdata  = qp_host_pixdata;
+            host->comms_vtable           = *driver->comms_vtable;
+            host->comms_vtable.comms_start = qp_host_comms_start;
+            host->comms_vtable.comms_stop  = qp_host_comms_stop;
+            driver->driver_vtable        = &host->driver_vtable;
+            driver->comms_vtable         = &host->comms_vtable;
+            memset(&host->stats, 0, sizeof(host->stats));
+            host->comms_started = false;
+            return surface;
+        }
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Statistics
+
+qp_host_stats_t qp_host_get_stats(painter_device_t device) {
+    qp_host_device_t *host = qp_host_find(device);
+    return host->stats;
+}
+
+void qp_host_reset_stats(painter_device_t device) {
+    qp_host_device_t *host = qp_host_find(device);
+    memset(&host->stats, 0, sizeof(host->stats));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Output
+
+// The surface stores pixels byte-swapped, ready for transmission to big-endian SPI displays
+static void qp_host_pixel_to_rgb888(uint16_t pixel, uint8_t *rgb) {
+    uint16_t rgb565 = __builtin_bswap16(pixel);
+    uint8_t  r      = (rgb565 >> 11) & 0x1F;
+    uint8_t  g      = (rgb565 >> 5) & 0x3F;
+    uint8_t  b      = rgb565 & 0x1F;
+    rgb[0]          = (r << 3) | (r >> 2);
+    rgb[1]          = (g << 2) | (g >> 4);
+    rgb[2]          = (b << 3) | (b >> 2);
+}
+
+uint32_t qp_host_hash(painter_device_t device) {
+    qp_host_device_t *host   = qp_host_find(device);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    uint32_t          hash   = 0x811C9DC5;
+    for (uint32_t i = 0; i < (uint32_t)driver->panel_width * driver->panel_height; ++i) {
+        uint8_t rgb[3];
+        qp_host_pixel_to_rgb888(host->buffer[i], rgb);
+        for (int j = 0; j < 3; ++j) {
+            hash = (hash ^ rgb[j]) * 0x01000193;
+        }
+    }
+    return hash;
+}
+
+bool qp_host_write_ppm(painter_device_t device, const char *filename) {
+    qp_host_device_t *host   = qp_host_find(device);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    FILE *            f      = fopen(filename, "wb");
+    if (!f) {
+        return false;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", (int)driver->panel_width, (int)driver->panel_height);
+    for (uint32_t i = 0; i < (uint32_t)driver->panel_width * driver->panel_height; ++i) {
+        uint8_t rgb[3];
+        qp_host_pixel_to_rgb888(host->buffer[i], rgb);
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+
+    return fclose(f) == 0;
+}
+
+// PNG output, using uncompressed deflate blocks so no external libraries are required
+
+static uint32_t qp_host_crc32(uint32_t crc, const uint8_t *data, uint32_t length) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; ++j) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static void qp_host_put_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static bool qp_host_write_png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t length) {
+    uint8_t header[8];
+    qp_host_put_be32(header, length);
+    memcpy(&header[4], type, 4);
+
+    uint8_t crc[4];
+    qp_host_put_be32(crc, qp_host_crc32(qp_host_crc32(0, &header[4], 4), data, length));
+
+    return fwrite(header, 1, sizeof(header), f) == sizeof(header) && fwrite(data, 1, length, f) == length && fwrite(crc, 1, sizeof(crc), f) == sizeof(crc);
+}
+
+bool qp_host_write_png(painter_device_t device, const char *filename) {
+    qp_host_device_t *host   = qp_host_find(device);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    uint32_t          width  = driver->panel_width;
+    uint32_t          height = driver->panel_height;
+
+    // Raw image data -- each scanline is prefixed with filter type 0 (none)
+    uint32_t stride   = 1 + width * 3;
+    uint32_t raw_size = stride * height;
+    uint8_t *raw      = malloc(raw_size);
+    if (!raw) {
+        return false;
+    }
+    for (uint32_t y = 0; y < height; ++y) {
+        raw[y * stride] = 0;
+        for (uint32_t x = 0; x < width; ++x) {
+            qp_host_pixel_to_rgb888(host->buffer[y * width + x], &raw[y * stride + 1 + x * 3]);
+        }
+    }
+
+    // Wrap it in a zlib stream made up of stored deflate blocks
+    uint32_t num_blocks = (raw_size + 65534) / 65535;
+    uint32_t zlib_size  = 2 + raw_size + (num_blocks * 5) + 4;
+    uint8_t *zlib       = malloc(zlib_size);
+    if (!zlib) {
+        free(raw);
+        return false;
+    }
+
+    uint8_t *p = zlib;
+    *p++       = 0x78;
+    *p++       = 0x01;
+    uint32_t a = 1, b = 0;
+    for (uint32_t offset = 0; offset < raw_size;) {
+        uint16_t block = (uint16_t)QP_MIN(raw_size - offset, 65535u);
+        *p++           = (offset + block == raw_size) ? 1 : 0;
+        *p++           = block & 0xFF;
+        *p++           = block >> 8;
+        *p++           = ~block & 0xFF;
+        *p++           = (uint16_t)~block >> 8;
+        memcpy(p, &raw[offset], block);
+        for (uint32_t i = 0; i < block; ++i) {
+            a = (a + raw[offset + i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        p += block;
+        offset += block;
+    }
+    qp_host_put_be32(p, (b << 16) | a);
+
+    uint8_t ihdr[13];
+    qp_host_put_be32(&ihdr[0], width);
+    qp_host_put_be32(&ihdr[4], height);
+    ihdr[8]  = 8; // bit depth
+    ihdr[9]  = 2; // truecolour
+    ihdr[10] = 0; // deflate
+    ihdr[11] = 0; // adaptive filtering
+    ihdr[12] = 0; // no interlace
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    bool  ok = false;
+    FILE *f  = fopen(filename, "wb");
+    if (f) {
+        ok = fwrite(signature, 1, sizeof(signature), f) == sizeof(signature) && qp_host_write_png_chunk(f, "IHDR", ihdr, sizeof(ihdr)) && qp_host_write_png_chunk(f, "IDAT", zlib, zlib_size) && qp_host_write_png_chunk(f, "IEND", NULL, 0);
+        ok = (fclose(f) == 0) && ok;
+    }
+
+    free(zlib);
+    free(raw);
+    return ok;
+}
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash
+
+#    include "flash_spi.h"
+
+static uint8_t               host_flash[QP_HOST_FLASH_SIZE];
+static qp_host_flash_stats_t host_flash_stats = {0};
+
+void qp_host_flash_write(uint32_t address, const void *data, uint32_t length) {
+    memcpy(&host_flash[address], data, length);
+}
+
+qp_host_flash_stats_t qp_host_flash_get_stats(void) {
+    return host_flash_stats;
+}
+
+void qp_host_flash_reset_stats(void) {
+    memset(&host_flash_stats, 0, sizeof(host_flash_stats));
+}
+
+// Stands in for the SPI flash driver. A display with started comms holds the bus the flash chip sits on, so reads are
+// refused in the same way as the real driver refuses them when it cannot start the bus.
+flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
+    for (int i = 0; i < QP_HOST_NUM_DEVICES; ++i) {
+        if (host_devices[i].surface != NULL && host_devices[i].comms_started) {
+            host_flash_stats.bus_conflicts++;
+            memset(buf, 0, len);
+            return FLASH_STATUS_ERROR;
+        }
+    }
+
+    if (addr + len > sizeof(host_flash)) {
+        memset(buf, 0, len);
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+
+    host_flash_stats.reads++;
+    memcpy(buf, &host_flash[addr], len);
+    return FLASH_STATUS_SUCCESS;
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
@@ -0,0 +1,104 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "qp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter host rendering backend
+//
+// Wraps an RGB565 surface so that it can be used as a stand-in for a real display when running on the host. All
+// drawing is rendered into memory, and the traffic that would have been sent to the display is counted so that the
+// cost of each operation can be tracked.
+
+#ifndef QP_HOST_NUM_DEVICES
+#    define QP_HOST_NUM_DEVICES RGB565_SURFACE_NUM_DEVICES
+#endif
+
+typedef struct qp_host_stats_t {
+    uint32_t transactions;   // number of qp_comms_start/qp_comms_stop pairs
+    uint32_t viewport_calls; // number of times the drawing window was set
+    uint32_t pixdata_calls;  // number of pixel data transfers
+    uint32_t pixdata_bytes;  // number of bytes of pixel data transferred
+} qp_host_stats_t;
+
+/**
+ * Factory method for a host rendering device.
+ *
+ * @param width[in] the width of the virtual display
+ * @param height[in] the height of the virtual display
+ * @param buffer[in] pointer to a preallocated buffer of size `(sizeof(uint16_t) * width * height)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_host_make_device(uint16_t width, uint16_t height, void *buffer);
+
+/**
+ * Retrieves the traffic statistics accumulated since the device was created, or since the last reset.
+ */
+qp_host_stats_t qp_host_get_stats(painter_device_t device);
+
+/**
+ * Resets the traffic statistics for the supplied device.
+ */
+void qp_host_reset_stats(painter_device_t device);
+
+/**
+ * Computes a 32-bit FNV-1a hash of the rendered contents of the device, suitable for golden comparisons.
+ */
+uint32_t qp_host_hash(painter_device_t device);
+
+/**
+ * Writes the rendered contents of the device to a binary PPM (P6) file.
+ */
+bool qp_host_write_ppm(painter_device_t device, const char *filename);
+
+/**
+ * Writes the rendered contents of the device to a PNG file.
+ */
+bool qp_host_write_png(painter_device_t device, const char *filename);
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Host external flash
+//
+// A RAM-backed stand-in for the SPI flash driver, so that flash-backed assets can be loaded on the host. Reads made
+// while a display's comms are started are treated as a bus conflict and fail, as they would on real hardware.
+
+#    ifndef QP_HOST_FLASH_SIZE
+#        define QP_HOST_FLASH_SIZE 4096
+#    endif
+
+typedef struct qp_host_flash_stats_t {
+    uint32_t reads;         // number of successful reads
+    uint32_t bus_conflicts; // number of reads attempted while a display held the bus
+} qp_host_flash_stats_t;
+
+/**
+ * Writes the supplied data into the host flash at the given address.
+ */
+void qp_host_flash_write(uint32_t address, const void *data, uint32_t length);
+
+/**
+ * Retrieves the flash statistics accumulated since startup, or since the last reset.
+ */
+qp_host_flash_stats_t qp_host_flash_get_stats(void);
+
+/**
+ * Resets the flash statistics.
+ */
+void qp_host_flash_reset_stats(void);
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,12 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS += rgb565_surface
+
+SRC += qp_host.c test_assets.c
+
+# Flash-backed assets are read from a RAM-backed stand-in rather than over SPI
+OPT_DEFS += -DQUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+COMMON_VPATH += $(DRIVER_PATH)/flash
@@ -0,0 +1,152 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_assets.h"
+
+const uint32_t gfx_test_card_length = 391;
+
+// clang-format off
+const uint8_t gfx_test_card[391] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0x87, 0x01, 0x00, 0x00, 0x78, 0xFE, 0xFF,
+    0xFF, 0x20, 0x00, 0x18, 0x00, 0x01, 0x00, 0x01, 0xFE, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x02, 0xFD, 0x06, 0x00, 0x00, 0x06, 0x00, 0x01, 0xFF, 0x00, 0x00, 0x03, 0xFC, 0x30, 0x00, 0x00,
+    0x00, 0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0x20, 0xFF, 0xFF, 0x30, 0xFF, 0xFF, 0x40, 0xFF, 0xFF, 0x50,
+    0xFF, 0xFF, 0x60, 0xFF, 0xFF, 0x70, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00,
+    0x48, 0x00, 0x00, 0x6D, 0x00, 0x00, 0x91, 0x00, 0x00, 0xB6, 0x00, 0x00, 0xDA, 0x00, 0x00, 0xFF,
+    0x05, 0xFA, 0x22, 0x01, 0x00, 0x04, 0x00, 0x04, 0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04,
+    0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04, 0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04,
+    0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04, 0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04,
+    0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04, 0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04,
+    0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04, 0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04,
+    0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04, 0x22, 0x04, 0x44, 0x04, 0x66, 0x04, 0x00, 0x04,
+    0x22, 0x04, 0x44, 0x04, 0x66, 0x02, 0x88, 0x02, 0x99, 0x02, 0xAA, 0x02, 0xBB, 0x02, 0xCC, 0x02,
+    0xDD, 0x02, 0xEE, 0x02, 0xFF, 0x02, 0x88, 0x02, 0x99, 0x02, 0xAA, 0x02, 0xBB, 0x02, 0xCC, 0x02,
+    0xDD, 0x02, 0xEE, 0x02, 0xFF, 0x02, 0x88, 0x02, 0x99, 0x02, 0xAA, 0x02, 0xBB, 0x02, 0xCC, 0x02,
+    0xDD, 0x02, 0xEE, 0x02, 0xFF, 0x02, 0x88, 0x02, 0x99, 0x02, 0xAA, 0x02, 0xBB, 0x02, 0xCC, 0x02,
+    0xDD, 0x02, 0xEE, 0x02, 0xFF, 0x02, 0x88, 0x02, 0x99, 0x02, 0xAA, 0x02, 0xBB, 0x02, 0xCC, 0x02,
+    0xDD, 0x02, 0xEE, 0x02, 0xFF, 0x02, 0x88, 0x02, 0x99, 0x02, 0xAA, 0x02, 0xBB, 0x02, 0xCC, 0x02,
+    0xDD, 0x02, 0xEE, 0x03, 0xFF, 0x9D, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF,
+    0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF,
+    0x88, 0xFF, 0x88, 0xFF, 0x02, 0x88, 0x9D, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF,
+    0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF,
+    0x88, 0xFF, 0x88, 0xFF, 0x88, 0x02, 0xFF, 0x9E, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF,
+    0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF,
+    0x88, 0xFF, 0x88, 0xFF, 0x88, 0xFF, 0x88,
+};
+// clang-format on
+
+const uint32_t gfx_test_anim_length = 247;
+
+// clang-format off
+const uint8_t gfx_test_anim[247] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0xF7, 0x00, 0x00, 0x00, 0x08, 0xFF, 0xFF,
+    0xFF, 0x10, 0x00, 0x10, 0x00, 0x04, 0x00, 0x01, 0xFE, 0x10, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0x00, 0x00, 0xA5, 0x00, 0x00, 0x00, 0xCE, 0x00, 0x00, 0x00, 0x02, 0xFD, 0x06, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0x28, 0x00, 0x05, 0xFA, 0x40, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x01, 0x00, 0x00, 0x40, 0xF1, 0x0F, 0x00, 0x40, 0xB1, 0x0E, 0x00, 0x40, 0xB1, 0x0E, 0x00, 0x40,
+    0xF1, 0x0F, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40,
+    0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40,
+    0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x02, 0xFD, 0x06, 0x00,
+    0x00, 0x01, 0x02, 0x00, 0xFF, 0x28, 0x00, 0x04, 0xFB, 0x08, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00,
+    0x0D, 0x00, 0x05, 0x00, 0x05, 0xFA, 0x0C, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xEB, 0x00,
+    0x00, 0xEB, 0x00, 0x00, 0xFF, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x02, 0x00, 0xFF, 0x28, 0x00,
+    0x04, 0xFB, 0x08, 0x00, 0x00, 0x0A, 0x00, 0x02, 0x00, 0x0D, 0x00, 0x0D, 0x00, 0x05, 0xFA, 0x0C,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xEB, 0xEB, 0xFF, 0x02, 0xFD,
+    0x06, 0x00, 0x00, 0x01, 0x02, 0x00, 0xFF, 0x28, 0x00, 0x04, 0xFB, 0x08, 0x00, 0x00, 0x02, 0x00,
+    0x0A, 0x00, 0x0D, 0x00, 0x0D, 0x00, 0x05, 0xFA, 0x0C, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xEB, 0x00,
+    0x00, 0xEB, 0x00, 0x00, 0xFF, 0x00, 0x00,
+};
+// clang-format on
+
+const uint32_t font_test_3x5_length = 619;
+
+// clang-format off
+const uint8_t font_test_3x5[619] = {
+    0x00, 0xFF, 0x14, 0x00, 0x00, 0x51, 0x46, 0x46, 0x01, 0x6B, 0x02, 0x00, 0x00, 0x94, 0xFD, 0xFF,
+    0xFF, 0x06, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xFE, 0x1D, 0x01, 0x00, 0x04, 0x00,
+    0x00, 0xC4, 0x00, 0x00, 0x84, 0x01, 0x00, 0x44, 0x02, 0x00, 0x04, 0x03, 0x00, 0xC4, 0x03, 0x00,
+    0x84, 0x04, 0x00, 0x44, 0x05, 0x00, 0x04, 0x06, 0x00, 0xC4, 0x06, 0x00, 0x84, 0x07, 0x00, 0x44,
+    0x08, 0x00, 0x04, 0x09, 0x00, 0xC4, 0x09, 0x00, 0x84, 0x0A, 0x00, 0x44, 0x0B, 0x00, 0x04, 0x0C,
+    0x00, 0xC4, 0x0C, 0x00, 0x84, 0x0D, 0x00, 0x44, 0x0E, 0x00, 0x04, 0x0F, 0x00, 0xC4, 0x0F, 0x00,
+    0x84, 0x10, 0x00, 0x44, 0x11, 0x00, 0x04, 0x12, 0x00, 0xC4, 0x12, 0x00, 0x84, 0x13, 0x00, 0x44,
+    0x14, 0x00, 0x04, 0x15, 0x00, 0xC4, 0x15, 0x00, 0x84, 0x16, 0x00, 0x44, 0x17, 0x00, 0x04, 0x18,
+    0x00, 0xC4, 0x18, 0x00, 0x84, 0x19, 0x00, 0x44, 0x1A, 0x00, 0x04, 0x1B, 0x00, 0xC4, 0x1B, 0x00,
+    0x84, 0x1C, 0x00, 0x44, 0x1D, 0x00, 0x04, 0x1E, 0x00, 0xC4, 0x1E, 0x00, 0x84, 0x1F, 0x00, 0x44,
+    0x20, 0x00, 0x04, 0x21, 0x00, 0xC4, 0x21, 0x00, 0x84, 0x22, 0x00, 0x44, 0x23, 0x00, 0x04, 0x24,
+    0x00, 0xC4, 0x24, 0x00, 0x84, 0x25, 0x00, 0x44, 0x26, 0x00, 0x04, 0x27, 0x00, 0xC4, 0x27, 0x00,
+    0x84, 0x28, 0x00, 0x44, 0x29, 0x00, 0x04, 0x2A, 0x00, 0xC4, 0x2A, 0x00, 0x84, 0x2B, 0x00, 0x44,
+    0x2C, 0x00, 0x04, 0x2D, 0x00, 0xC4, 0x2D, 0x00, 0x84, 0x2E, 0x00, 0x44, 0x2F, 0x00, 0x04, 0x30,
+    0x00, 0xC4, 0x30, 0x00, 0x84, 0x31, 0x00, 0x44, 0x32, 0x00, 0x04, 0x33, 0x00, 0xC4, 0x33, 0x00,
+    0x84, 0x34, 0x00, 0x44, 0x35, 0x00, 0x04, 0x36, 0x00, 0xC4, 0x36, 0x00, 0x84, 0x37, 0x00, 0x44,
+    0x38, 0x00, 0x04, 0x39, 0x00, 0xC4, 0x39, 0x00, 0x84, 0x3A, 0x00, 0x44, 0x3B, 0x00, 0x04, 0x3C,
+    0x00, 0xC4, 0x3C, 0x00, 0x84, 0x3D, 0x00, 0x44, 0x3E, 0x00, 0x04, 0x3F, 0x00, 0xC4, 0x3F, 0x00,
+    0x84, 0x40, 0x00, 0x44, 0x41, 0x00, 0x04, 0x42, 0x00, 0xC4, 0x42, 0x00, 0x84, 0x43, 0x00, 0x44,
+    0x44, 0x00, 0x04, 0x45, 0x00, 0xC4, 0x45, 0x00, 0x84, 0x46, 0x00, 0x02, 0xFD, 0x06, 0x00, 0x00,
+    0x65, 0x26, 0x00, 0x44, 0x47, 0x00, 0x05, 0xFA, 0x20, 0x01, 0x00, 0x00, 0x00, 0x00, 0x22, 0x02,
+    0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x45, 0x12, 0x05, 0x47, 0x02, 0x02,
+    0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47,
+    0x02, 0x02, 0x00, 0x07, 0x00, 0x00, 0x00, 0x02, 0x44, 0x12, 0x01, 0x57, 0x55, 0x07, 0x32, 0x22,
+    0x07, 0x47, 0x17, 0x07, 0x47, 0x47, 0x07, 0x55, 0x47, 0x04, 0x17, 0x47, 0x07, 0x17, 0x57, 0x07,
+    0x47, 0x44, 0x04, 0x57, 0x57, 0x07, 0x57, 0x47, 0x07, 0x20, 0x20, 0x00, 0x47, 0x02, 0x02, 0x47,
+    0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x52, 0x57,
+    0x05, 0x53, 0x53, 0x03, 0x16, 0x11, 0x06, 0x53, 0x55, 0x03, 0x17, 0x13, 0x07, 0x17, 0x13, 0x01,
+    0x16, 0x55, 0x06, 0x55, 0x57, 0x05, 0x27, 0x22, 0x07, 0x44, 0x54, 0x02, 0x55, 0x53, 0x05, 0x11,
+    0x11, 0x07, 0x75, 0x57, 0x05, 0x53, 0x55, 0x05, 0x52, 0x55, 0x02, 0x53, 0x13, 0x01, 0x52, 0x35,
+    0x06, 0x53, 0x53, 0x05, 0x16, 0x42, 0x03, 0x27, 0x22, 0x02, 0x55, 0x55, 0x07, 0x55, 0x55, 0x02,
+    0x55, 0x77, 0x05, 0x55, 0x52, 0x05, 0x55, 0x22, 0x02, 0x47, 0x12, 0x07, 0x47, 0x02, 0x02, 0x47,
+    0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x52, 0x57,
+    0x05, 0x53, 0x53, 0x03, 0x16, 0x11, 0x06, 0x53, 0x55, 0x03, 0x17, 0x13, 0x07, 0x17, 0x13, 0x01,
+    0x16, 0x55, 0x06, 0x55, 0x57, 0x05, 0x27, 0x22, 0x07, 0x44, 0x54, 0x02, 0x55, 0x53, 0x05, 0x11,
+    0x11, 0x07, 0x75, 0x57, 0x05, 0x53, 0x55, 0x05, 0x52, 0x55, 0x02, 0x53, 0x13, 0x01, 0x52, 0x35,
+    0x06, 0x53, 0x53, 0x05, 0x16, 0x42, 0x03, 0x27, 0x22, 0x02, 0x55, 0x55, 0x07, 0x55, 0x55, 0x02,
+    0x55, 0x77, 0x05, 0x55, 0x52, 0x05, 0x55, 0x22, 0x02, 0x47, 0x12, 0x07, 0x47, 0x02, 0x02, 0x47,
+    0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x75, 0x27, 0x00,
+};
+// clang-format on
+
+const uint32_t font_test_3x5_palette_length = 630;
+
+// clang-format off
+const uint8_t font_test_3x5_palette[630] = {
+    0x00, 0xFF, 0x14, 0x00, 0x00, 0x51, 0x46, 0x46, 0x01, 0x76, 0x02, 0x00, 0x00, 0x89, 0xFD, 0xFF,
+    0xFF, 0x06, 0x01, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0xFE, 0x1D, 0x01, 0x00, 0x04, 0x00,
+    0x00, 0xC4, 0x00, 0x00, 0x84, 0x01, 0x00, 0x44, 0x02, 0x00, 0x04, 0x03, 0x00, 0xC4, 0x03, 0x00,
+    0x84, 0x04, 0x00, 0x44, 0x05, 0x00, 0x04, 0x06, 0x00, 0xC4, 0x06, 0x00, 0x84, 0x07, 0x00, 0x44,
+    0x08, 0x00, 0x04, 0x09, 0x00, 0xC4, 0x09, 0x00, 0x84, 0x0A, 0x00, 0x44, 0x0B, 0x00, 0x04, 0x0C,
+    0x00, 0xC4, 0x0C, 0x00, 0x84, 0x0D, 0x00, 0x44, 0x0E, 0x00, 0x04, 0x0F, 0x00, 0xC4, 0x0F, 0x00,
+    0x84, 0x10, 0x00, 0x44, 0x11, 0x00, 0x04, 0x12, 0x00, 0xC4, 0x12, 0x00, 0x84, 0x13, 0x00, 0x44,
+    0x14, 0x00, 0x04, 0x15, 0x00, 0xC4, 0x15, 0x00, 0x84, 0x16, 0x00, 0x44, 0x17, 0x00, 0x04, 0x18,
+    0x00, 0xC4, 0x18, 0x00, 0x84, 0x19, 0x00, 0x44, 0x1A, 0x00, 0x04, 0x1B, 0x00, 0xC4, 0x1B, 0x00,
+    0x84, 0x1C, 0x00, 0x44, 0x1D, 0x00, 0x04, 0x1E, 0x00, 0xC4, 0x1E, 0x00, 0x84, 0x1F, 0x00, 0x44,
+    0x20, 0x00, 0x04, 0x21, 0x00, 0xC4, 0x21, 0x00, 0x84, 0x22, 0x00, 0x44, 0x23, 0x00, 0x04, 0x24,
+    0x00, 0xC4, 0x24, 0x00, 0x84, 0x25, 0x00, 0x44, 0x26, 0x00, 0x04, 0x27, 0x00, 0xC4, 0x27, 0x00,
+    0x84, 0x28, 0x00, 0x44, 0x29, 0x00, 0x04, 0x2A, 0x00, 0xC4, 0x2A, 0x00, 0x84, 0x2B, 0x00, 0x44,
+    0x2C, 0x00, 0x04, 0x2D, 0x00, 0xC4, 0x2D, 0x00, 0x84, 0x2E, 0x00, 0x44, 0x2F, 0x00, 0x04, 0x30,
+    0x00, 0xC4, 0x30, 0x00, 0x84, 0x31, 0x00, 0x44, 0x32, 0x00, 0x04, 0x33, 0x00, 0xC4, 0x33, 0x00,
+    0x84, 0x34, 0x00, 0x44, 0x35, 0x00, 0x04, 0x36, 0x00, 0xC4, 0x36, 0x00, 0x84, 0x37, 0x00, 0x44,
+    0x38, 0x00, 0x04, 0x39, 0x00, 0xC4, 0x39, 0x00, 0x84, 0x3A, 0x00, 0x44, 0x3B, 0x00, 0x04, 0x3C,
+    0x00, 0xC4, 0x3C, 0x00, 0x84, 0x3D, 0x00, 0x44, 0x3E, 0x00, 0x04, 0x3F, 0x00, 0xC4, 0x3F, 0x00,
+    0x84, 0x40, 0x00, 0x44, 0x41, 0x00, 0x04, 0x42, 0x00, 0xC4, 0x42, 0x00, 0x84, 0x43, 0x00, 0x44,
+    0x44, 0x00, 0x04, 0x45, 0x00, 0xC4, 0x45, 0x00, 0x84, 0x46, 0x00, 0x02, 0xFD, 0x06, 0x00, 0x00,
+    0x65, 0x26, 0x00, 0x44, 0x47, 0x00, 0x03, 0xFC, 0x06, 0x00, 0x00, 0xAA, 0xFF, 0x40, 0x2B, 0xFF,
+    0xFF, 0x05, 0xFA, 0x20, 0x01, 0x00, 0x00, 0x00, 0x00, 0x22, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47,
+    0x02, 0x02, 0x47, 0x02, 0x02, 0x45, 0x12, 0x05, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02,
+    0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x00, 0x07, 0x00,
+    0x00, 0x00, 0x02, 0x44, 0x12, 0x01, 0x57, 0x55, 0x07, 0x32, 0x22, 0x07, 0x47, 0x17, 0x07, 0x47,
+    0x47, 0x07, 0x55, 0x47, 0x04, 0x17, 0x47, 0x07, 0x17, 0x57, 0x07, 0x47, 0x44, 0x04, 0x57, 0x57,
+    0x07, 0x57, 0x47, 0x07, 0x20, 0x20, 0x00, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02,
+    0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x52, 0x57, 0x05, 0x53, 0x53, 0x03, 0x16,
+    0x11, 0x06, 0x53, 0x55, 0x03, 0x17, 0x13, 0x07, 0x17, 0x13, 0x01, 0x16, 0x55, 0x06, 0x55, 0x57,
+    0x05, 0x27, 0x22, 0x07, 0x44, 0x54, 0x02, 0x55, 0x53, 0x05, 0x11, 0x11, 0x07, 0x75, 0x57, 0x05,
+    0x53, 0x55, 0x05, 0x52, 0x55, 0x02, 0x53, 0x13, 0x01, 0x52, 0x35, 0x06, 0x53, 0x53, 0x05, 0x16,
+    0x42, 0x03, 0x27, 0x22, 0x02, 0x55, 0x55, 0x07, 0x55, 0x55, 0x02, 0x55, 0x77, 0x05, 0x55, 0x52,
+    0x05, 0x55, 0x22, 0x02, 0x47, 0x12, 0x07, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02,
+    0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x52, 0x57, 0x05, 0x53, 0x53, 0x03, 0x16,
+    0x11, 0x06, 0x53, 0x55, 0x03, 0x17, 0x13, 0x07, 0x17, 0x13, 0x01, 0x16, 0x55, 0x06, 0x55, 0x57,
+    0x05, 0x27, 0x22, 0x07, 0x44, 0x54, 0x02, 0x55, 0x53, 0x05, 0x11, 0x11, 0x07, 0x75, 0x57, 0x05,
+    0x53, 0x55, 0x05, 0x52, 0x55, 0x02, 0x53, 0x13, 0x01, 0x52, 0x35, 0x06, 0x53, 0x53, 0x05, 0x16,
+    0x42, 0x03, 0x27, 0x22, 0x02, 0x55, 0x55, 0x07, 0x55, 0x55, 0x02, 0x55, 0x77, 0x05, 0x55, 0x52,
+    0x05, 0x55, 0x22, 0x02, 0x47, 0x12, 0x07, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02, 0x47, 0x02, 0x02,
+    0x47, 0x02, 0x02, 0x75, 0x27, 0x00,
+};
+// clang-format on
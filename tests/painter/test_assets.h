@@ -0,0 +1,32 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Assets used by the Quantum Painter golden tests:
+//   gfx_test_card -- 32x24, 16-colour palette, RLE-compressed
+//   gfx_test_anim -- 16x16, 4-level greyscale, 4 frames of 40ms each, frames 2-4 stored as deltas
+//   font_test_3x5 -- 1bpp, 3x5 glyphs, ASCII and U+2665
+//   font_test_3x5_palette -- font_test_3x5 with a 2-colour palette, yellow on dark blue
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const uint32_t gfx_test_card_length;
+extern const uint8_t  gfx_test_card[391];
+
+extern const uint32_t gfx_test_anim_length;
+extern const uint8_t  gfx_test_anim[247];
+
+extern const uint32_t font_test_3x5_length;
+extern const uint8_t  font_test_3x5[619];
+
+extern const uint32_t font_test_3x5_palette_length;
+extern const uint8_t  font_test_3x5_palette[630];
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,195 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "color.h"
+#include "qp_host.h"
+#include "test_assets.h"
+
+extern "C" {
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+#define DISPLAY_WIDTH 64
+#define DISPLAY_HEIGHT 48
+
+class QuantumPainter : public ::testing::Test {
+   protected:
+    static painter_device_t display;
+    static uint16_t         framebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+    void SetUp() override {
+        if (display == nullptr) {
+            display = qp_host_make_device(DISPLAY_WIDTH, DISPLAY_HEIGHT, framebuffer);
+        }
+        ASSERT_NE(display, nullptr);
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+        ASSERT_TRUE(qp_rect(display, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1, 0, 0, 0, true));
+        qp_host_reset_stats(display);
+    }
+
+    // Compares the rendered output against its golden hash, dumping the image alongside the test binary on mismatch
+    // so that it can be inspected -- or adopted as the new golden image if the change was intentional.
+    void expect_golden(const char *name, uint32_t expected) {
+        uint32_t actual = qp_host_hash(display);
+        EXPECT_EQ(actual, expected) << "rendered output of '" << name << "' differs from golden";
+        if (actual != expected) {
+            std::string filename = std::string(".build/test/painter_") + name + ".png";
+            if (qp_host_write_png(display, filename.c_str())) {
+                std::cerr << "Wrote " << filename << std::endl;
+            }
+        }
+    }
+};
+
+painter_device_t QuantumPainter::display = nullptr;
+uint16_t         QuantumPainter::framebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+TEST_F(QuantumPainter, renders_primitives) {
+    EXPECT_TRUE(qp_rect(display, 2, 2, 29, 21, HSV_RED, false));
+    EXPECT_TRUE(qp_rect(display, 34, 2, 61, 21, HSV_GREEN, true));
+    EXPECT_TRUE(qp_line(display, 0, 47, 63, 24, HSV_WHITE));
+    EXPECT_TRUE(qp_line(display, 0, 24, 63, 47, HSV_YELLOW));
+    EXPECT_TRUE(qp_circle(display, 16, 35, 10, HSV_BLUE, false));
+    EXPECT_TRUE(qp_ellipse(display, 48, 35, 14, 8, HSV_MAGENTA, true));
+    EXPECT_TRUE(qp_setpixel(display, 63, 0, HSV_CYAN));
+    expect_golden("primitives", 0xD2ED2EE1);
+}
+
+TEST_F(QuantumPainter, clips_primitives_at_panel_edges) {
+    // Filled circle and ellipse extending past the left and top edges, outlined circle past the right edge
+    EXPECT_TRUE(qp_circle(display, 2, 24, 10, HSV_BLUE, true));
+    EXPECT_TRUE(qp_ellipse(display, 32, 1, 12, 6, HSV_GREEN, true));
+    EXPECT_TRUE(qp_circle(display, 60, 24, 8, HSV_RED, false));
+
+    // Only on-screen pixels should have been sent, rather than spans wrapping around to the far side of the panel
+    qp_host_stats_t stats = qp_host_get_stats(display);
+    EXPECT_LE(stats.pixdata_bytes, 3u * DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t));
+
+    auto pixel = [](int x, int y) { return framebuffer[y * DISPLAY_WIDTH + x]; };
+    EXPECT_NE(pixel(0, 24), 0) << "left edge of the filled circle should be drawn";
+    EXPECT_NE(pixel(12, 24), 0) << "right edge of the filled circle should be drawn";
+    EXPECT_EQ(pixel(13, 24), 0) << "filled circle should not extend past its radius";
+    EXPECT_EQ(pixel(30, 24), 0) << "nothing should be drawn between the circles";
+    EXPECT_NE(pixel(32, 0), 0) << "top of the filled ellipse should be drawn";
+    EXPECT_EQ(pixel(32, 8), 0) << "filled ellipse should not extend past its height";
+    EXPECT_NE(pixel(52, 24), 0) << "left edge of the outlined circle should be drawn";
+    EXPECT_EQ(pixel(60, 24), 0) << "outlined circle should not be filled";
+}
+
+TEST_F(QuantumPainter, renders_image) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_test_card);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->width, 32);
+    EXPECT_EQ(image->height, 24);
+
+    EXPECT_TRUE(qp_drawimage(display, 0, 0, image));
+    EXPECT_TRUE(qp_drawimage_recolor(display, 32, 24, image, HSV_RED, HSV_BLACK));
+    expect_golden("image", 0x6C62EF85);
+
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(QuantumPainter, renders_text) {
+    painter_font_handle_t font = qp_load_font_mem(font_test_3x5);
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(font->line_height, 6);
+
+    EXPECT_EQ(qp_textwidth(font, "QMK"), 12);
+    EXPECT_EQ(qp_drawtext(display, 1, 1, font, "Hello, QMK!"), 44);
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 8, font, "0123456789", HSV_GREEN, HSV_BLACK), 40);
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 15, font, "I \xE2\x99\xA5 QP", HSV_RED, HSV_BLUE), 24);
+    expect_golden("text", 0xB97AD0A5);
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(QuantumPainter, renders_assets_from_flash) {
+    // Assets are spread across the flash so that they need several read-ahead refills while being drawn
+    const uint32_t image_address = 0x100;
+    const uint32_t font_address  = 0x800;
+    qp_host_flash_write(image_address, gfx_test_card, gfx_test_card_length);
+    qp_host_flash_write(font_address, font_test_3x5, font_test_3x5_length);
+    qp_host_flash_reset_stats();
+
+    painter_image_handle_t image = qp_load_image_flash(image_address);
+    ASSERT_NE(image, nullptr);
+    EXPECT_TRUE(qp_drawimage(display, 0, 0, image));
+    EXPECT_TRUE(qp_drawimage_recolor(display, 32, 24, image, HSV_RED, HSV_BLACK));
+    expect_golden("image", 0x6C62EF85);
+    EXPECT_TRUE(qp_close_image(image));
+
+    ASSERT_TRUE(qp_rect(display, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1, 0, 0, 0, true));
+    painter_font_handle_t font = qp_load_font_flash(font_address);
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(qp_drawtext(display, 1, 1, font, "Hello, QMK!"), 44);
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 8, font, "0123456789", HSV_GREEN, HSV_BLACK), 40);
+    EXPECT_EQ(qp_drawtext_recolor(display, 1, 15, font, "I \xE2\x99\xA5 QP", HSV_RED, HSV_BLUE), 24);
+    expect_golden("text", 0xB97AD0A5);
+    EXPECT_TRUE(qp_close_font(font));
+
+    // The display's comms must have been handed back whenever the flash chip was read
+    qp_host_flash_stats_t stats = qp_host_flash_get_stats();
+    EXPECT_GT(stats.reads, 0u);
+    EXPECT_EQ(stats.bus_conflicts, 0u);
+}
+
+TEST_F(QuantumPainter, renders_animation_frames) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_test_anim);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->frame_count, 4);
+
+    // Frames 1-3 are stored as deltas against their predecessor; the final entry checks the loop back to frame 0
+    static const uint32_t expected[] = {0x2C68F475, 0x9707D9F5, 0x382020B5, 0xBCFA5335, 0x2C68F475};
+
+    deferred_token token = qp_animate(display, 24, 16, image);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+    for (size_t frame = 0; frame < sizeof(expected) / sizeof(expected[0]); ++frame) {
+        if (frame > 0) {
+            advance_time(40);
+            qp_internal_animation_tick();
+        }
+        std::string name = "animation_frame" + std::to_string(frame);
+        expect_golden(name.c_str(), expected[frame]);
+    }
+
+    qp_stop_animation(token);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(QuantumPainter, writes_valid_png) {
+    EXPECT_TRUE(qp_rect(display, 0, 0, 7, 7, HSV_WHITE, true));
+
+    const char *filename = ".build/test/painter_png_check.png";
+    ASSERT_TRUE(qp_host_write_png(display, filename));
+
+    std::vector<uint8_t> contents;
+    FILE                *f = fopen(filename, "rb");
+    ASSERT_NE(f, nullptr);
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        contents.push_back((uint8_t)c);
+    }
+    fclose(f);
+    remove(filename);
+
+    // signature + IHDR + IDAT(zlib header, one stored block, adler32) + IEND
+    const size_t raw_size = (1 + DISPLAY_WIDTH * 3) * DISPLAY_HEIGHT;
+    ASSERT_EQ(contents.size(), 8 + (12 + 13) + (12 + 2 + 5 + raw_size + 4) + 12);
+
+    static const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    EXPECT_EQ(memcmp(contents.data(), signature, sizeof(signature)), 0);
+    EXPECT_EQ(memcmp(&contents[12], "IHDR", 4), 0);
+    EXPECT_EQ(memcmp(&contents[contents.size() - 8], "IEND", 4), 0);
+
+    // First pixel of the first scanline is white, the pixel past the filled rect is black
+    const uint8_t *pixels = &contents[8 + 25 + 8 + 2 + 5];
+    EXPECT_EQ(pixels[0], 0);
+    EXPECT_EQ(pixels[1], 0xFF);
+    EXPECT_EQ(pixels[1 + 8 * 3], 0);
+}
@@ -0,0 +1,99 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "test_common.hpp"
+#include "qp_host.h"
+#include "test_assets.h"
+
+extern "C" {
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+#define DISPLAY_WIDTH 240
+#define DISPLAY_HEIGHT 135
+#define ITERATIONS 200
+
+// Times each drawing operation on the host, and records the display traffic it generates. The timings are only printed
+// for comparison between runs; the traffic counts are deterministic and are checked so that regressions in the amount
+// of data sent to the display are caught.
+class QuantumPainterBenchmark : public ::testing::Test {
+   protected:
+    static painter_device_t display;
+    static uint16_t         framebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+    void SetUp() override {
+        if (display == nullptr) {
+            display = qp_host_make_device(DISPLAY_WIDTH, DISPLAY_HEIGHT, framebuffer);
+        }
+        ASSERT_NE(display, nullptr);
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+    }
+
+    template <typename F>
+    qp_host_stats_t measure(const char *name, F &&op) {
+        qp_host_reset_stats(display);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            op();
+        }
+        auto            end   = std::chrono::steady_clock::now();
+        qp_host_stats_t stats = qp_host_get_stats(display);
+
+        double us = std::chrono::duration<double, std::micro>(end - start).count() / ITERATIONS;
+        printf("%-16s %10.2f us/op %6u viewports/op %8u bytes/op\n", name, us, (unsigned)(stats.viewport_calls / ITERATIONS), (unsigned)(stats.pixdata_bytes / ITERATIONS));
+
+        stats.transactions /= ITERATIONS;
+        stats.viewport_calls /= ITERATIONS;
+        stats.pixdata_calls /= ITERATIONS;
+        stats.pixdata_bytes /= ITERATIONS;
+        return stats;
+    }
+};
+
+painter_device_t QuantumPainterBenchmark::display = nullptr;
+uint16_t         QuantumPainterBenchmark::framebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+TEST_F(QuantumPainterBenchmark, drawimage) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_test_card);
+    ASSERT_NE(image, nullptr);
+
+    qp_host_stats_t stats = measure("qp_drawimage", [&] { qp_drawimage(display, 10, 10, image); });
+    EXPECT_EQ(stats.viewport_calls, 1);
+    EXPECT_EQ(stats.pixdata_bytes, 32 * 24 * 2);
+
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(QuantumPainterBenchmark, drawtext) {
+    painter_font_handle_t font = qp_load_font_mem(font_test_3x5);
+    ASSERT_NE(font, nullptr);
+
+    qp_host_stats_t stats = measure("qp_drawtext", [&] { qp_drawtext(display, 10, 10, font, "The quick brown fox"); });
+    EXPECT_EQ(stats.viewport_calls, 19);
+    EXPECT_EQ(stats.pixdata_bytes, 19 * 4 * 6 * 2);
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(QuantumPainterBenchmark, animation_tick) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_test_anim);
+    ASSERT_NE(image, nullptr);
+
+    deferred_token token = qp_animate(display, 10, 10, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    // Each iteration renders the next frame; the first frame was drawn by qp_animate
+    qp_host_stats_t stats = measure("animation tick", [&] {
+        advance_time(40);
+        qp_internal_animation_tick();
+    });
+    EXPECT_EQ(stats.viewport_calls, 1);
+    EXPECT_EQ(stats.pixdata_bytes, 200); // averaged over loops of one full frame and three delta frames
+
+    qp_stop_animation(token);
+    EXPECT_TRUE(qp_close_image(image));
+}
@@ -183,7 +183,7 @@ void flash_rgb (void) {
 void set_os (uint8_t os, bool update) {
   current_os = os;
   if (update) {
-    eeprom_update_byte(EECONFIG_USERSPACE, current_os);
+    eeconfig_update_byte(EECONFIG_USERSPACE, current_os);
   }
   switch (os) {
   case OS_MAC:
@@ -416,7 +416,7 @@ void leader_end_user(void) {
 }
 
 void matrix_init_user(void) {
-  current_os = eeprom_read_byte(EECONFIG_USERSPACE);
+  current_os = eeconfig_read_byte(EECONFIG_USERSPACE);
   set_os(current_os, false);
 }
 
@@ -25,20 +25,20 @@ void eeconfig_read_user_config(uint32_t *data) {
         memset(data, 0, 4);
     } else
 #endif
-        eeprom_read_block(data, EECONFIG_USER_TEMP, 4);
+        eeconfig_read_block(data, EECONFIG_USER_TEMP, 4);
 }
 
 void eeconfig_update_user_config(const uint32_t *data) {
-    eeprom_update_block(data, EECONFIG_USER_TEMP, 4);
+    eeconfig_update_block(data, EECONFIG_USER_TEMP, 4);
 #if (EECONFIG_USER_DATA_SIZE) > 0
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
 #endif
 }
 
 void eeconfig_read_user_data(void *data) {
 #if (EECONFIG_USER_DATA_SIZE) > 4
     if (eeconfig_is_user_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_USER_DATABLOCK + 4, (EECONFIG_USER_DATA_SIZE)-4);
+        eeconfig_read_block(data, EECONFIG_USER_DATABLOCK + 4, (EECONFIG_USER_DATA_SIZE)-4);
     } else {
         memset(data, 0, (EECONFIG_USER_DATA_SIZE));
     }
@@ -47,7 +47,7 @@ void eeconfig_read_user_data(void *data) {
 
 void eeconfig_update_user_data(const void *data) {
 #if (EECONFIG_USER_DATA_SIZE) > 4
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_USER_DATABLOCK + 4, (EECONFIG_USER_DATA_SIZE)-4);
+    eeconfig_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_USER_DATABLOCK + 4, (EECONFIG_USER_DATA_SIZE)-4);
 #endif
 }
@@ -168,7 +168,7 @@ void eeconfig_init_user(void) {
     set_unicode_input_mode(KUCHOSAURONAD0_UNICODE_MODE);
     get_unicode_input_mode();
   #else
-    eeprom_update_byte(EECONFIG_UNICODEMODE, KUCHOSAURONAD0_UNICODE_MODE);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, KUCHOSAURONAD0_UNICODE_MODE);
   #endif
   eeconfig_init_keymap();
   keyboard_init();
@@ -46,11 +46,11 @@ bool toggle_superduper_mode(void) {
 
 void set_superduper_key_combo_layer(uint16_t layer) {
     key_combos[CB_SUPERDUPER].keys = superduper_combos[layer];
-    eeprom_update_byte(EECONFIG_SUPERDUPER_INDEX, layer);
+    eeconfig_update_byte(EECONFIG_SUPERDUPER_INDEX, layer);
 }
 
 void set_superduper_key_combos(void) {
-    uint8_t layer = eeprom_read_byte(EECONFIG_SUPERDUPER_INDEX);
+    uint8_t layer = eeconfig_read_byte(EECONFIG_SUPERDUPER_INDEX);
 
     switch (layer) {
         case _QWERTY:
@@ -155,6 +155,6 @@ void eeconfig_init_user(void) {
     set_unicode_input_mode(YAD_UNICODE_MODE);
     get_unicode_input_mode();
   #else
-    eeprom_update_byte(EECONFIG_UNICODEMODE, YAD_UNICODE_MODE);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, YAD_UNICODE_MODE);
   #endif
 }